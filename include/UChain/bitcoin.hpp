@@ -133,6 +133,7 @@
 #include <UChain/bitcoin/utility/scope_lock.hpp>
 #include <UChain/bitcoin/utility/serializer.hpp>
 #include <UChain/bitcoin/utility/string.hpp>
+#include <UChain/bitcoin/utility/subscription_index.hpp>
 #include <UChain/bitcoin/utility/subscriber.hpp>
 #include <UChain/bitcoin/utility/synchronizer.hpp>
 #include <UChain/bitcoin/utility/thread.hpp>
@@ -38,6 +38,9 @@ namespace libbitcoin {
 namespace blockchain {
     class block_chain_impl;
 }
+namespace wallet {
+    class payment_address;
+}
 }
 
 namespace libbitcoin {
@@ -65,6 +68,7 @@ public:
     bool is_valid() const;
     code check_asset_address(bc::blockchain::block_chain_impl& chain) const;
     std::string get_script_address() const;
+    bool is_script_address(const wallet::payment_address& address) const;
     void reset();
     uint64_t serialized_size() const;
     uint64_t get_token_amount() const;
@@ -25,6 +25,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 #include <UChain/bitcoin/compat.hpp>
 #include <UChain/bitcoin/utility/asio.hpp>
 #include <UChain/bitcoin/utility/assert.hpp>
@@ -219,6 +220,15 @@ void notifier<Key, Args...>::relay(Args... args)
         this->shared_from_this(), args...);
 }
 
+template <typename Key, typename... Args>
+void notifier<Key, Args...>::relay_to(const std::vector<Key>& keys,
+    Args... args)
+{
+    // This enqueues work while maintaining order.
+    dispatch_.ordered(&notifier<Key, Args...>::do_invoke_to,
+        this->shared_from_this(), keys, args...);
+}
+
 // private
 template <typename Key, typename... Args>
 void notifier<Key, Args...>::do_invoke(Args... args)
@@ -267,6 +277,62 @@ void notifier<Key, Args...>::do_invoke(Args... args)
     ///////////////////////////////////////////////////////////////////////////
 }
 
+// private
+template <typename Key, typename... Args>
+void notifier<Key, Args...>::do_invoke_to(const std::vector<Key>& keys,
+    Args... args)
+{
+    // Critical Section (prevent concurrent handler execution)
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(invoke_mutex_);
+
+    for (const auto& key: keys)
+    {
+        // Critical Section (protect stop)
+        ///////////////////////////////////////////////////////////////////////
+        subscribe_mutex_.lock();
+
+        const auto it = subscriptions_.find(key);
+        if (it == subscriptions_.end())
+        {
+            subscribe_mutex_.unlock();
+            //-----------------------------------------------------------------
+            continue;
+        }
+
+        // Move the subscriber out so it is not invoked concurrently.
+        const auto entry = *it;
+        subscriptions_.erase(it);
+
+        subscribe_mutex_.unlock();
+        ///////////////////////////////////////////////////////////////////////
+
+        // Resubscribe as indicated, as with do_invoke.
+        if (entry.second.notify(args...))
+        {
+            // Critical Section
+            ///////////////////////////////////////////////////////////////////
+            subscribe_mutex_.lock_upgrade();
+
+            if (stopped_)
+            {
+                subscribe_mutex_.unlock_upgrade();
+                //-------------------------------------------------------------
+                continue;
+            }
+
+            subscribe_mutex_.unlock_upgrade_and_lock();
+            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+            subscriptions_.emplace(entry);
+
+            subscribe_mutex_.unlock();
+            ///////////////////////////////////////////////////////////////////
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 } // namespace libbitcoin
 
 #endif
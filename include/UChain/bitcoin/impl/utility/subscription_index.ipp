@@ -0,0 +1,200 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_SUBSCRIPTION_INDEX_IPP
+#define UC_SUBSCRIPTION_INDEX_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <boost/functional/hash.hpp>
+#include <UChain/bitcoin/utility/binary.hpp>
+#include <UChain/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+template <typename Subscriber, typename Compare>
+size_t subscription_index<Subscriber, Compare>::chunk_hash::operator()(
+    const data_chunk& value) const
+{
+    return boost::hash_range(value.begin(), value.end());
+}
+
+template <typename Subscriber, typename Compare>
+subscription_index<Subscriber, Compare>::subscription_index(size_t exact_bits)
+  : exact_bits_(exact_bits)
+{
+}
+
+template <typename Subscriber, typename Compare>
+void subscription_index<Subscriber, Compare>::add(const binary& filter,
+    const Subscriber& subscriber)
+{
+    auto& filters = filters_[subscriber];
+    if (std::find(filters.begin(), filters.end(), filter) != filters.end())
+        return;
+
+    filters.push_back(filter);
+
+    if (filter.size() == exact_bits_)
+    {
+        exact_[filter.blocks()].insert(subscriber);
+        return;
+    }
+
+    auto current = &root_;
+    for (size_t bit = 0; bit < filter.size(); ++bit)
+    {
+        auto& child = current->children[filter[bit] ? 1 : 0];
+        if (!child)
+            child.reset(new node);
+
+        current = child.get();
+    }
+
+    current->members.insert(subscriber);
+}
+
+template <typename Subscriber, typename Compare>
+void subscription_index<Subscriber, Compare>::remove(const binary& filter,
+    const Subscriber& subscriber)
+{
+    const auto it = filters_.find(subscriber);
+    if (it == filters_.end())
+        return;
+
+    auto& filters = it->second;
+    const auto position = std::find(filters.begin(), filters.end(), filter);
+    if (position == filters.end())
+        return;
+
+    filters.erase(position);
+    if (filters.empty())
+        filters_.erase(it);
+
+    erase(filter, subscriber);
+}
+
+template <typename Subscriber, typename Compare>
+void subscription_index<Subscriber, Compare>::remove(
+    const Subscriber& subscriber)
+{
+    const auto it = filters_.find(subscriber);
+    if (it == filters_.end())
+        return;
+
+    for (const auto& filter: it->second)
+        erase(filter, subscriber);
+
+    filters_.erase(it);
+}
+
+template <typename Subscriber, typename Compare>
+void subscription_index<Subscriber, Compare>::find(const binary& key,
+    subscribers& out) const
+{
+    if (key.size() >= exact_bits_ && !exact_.empty())
+    {
+        const auto exact = key.size() == exact_bits_ ? key :
+            key.substring(0, exact_bits_);
+
+        const auto it = exact_.find(exact.blocks());
+        if (it != exact_.end())
+            out.insert(it->second.begin(), it->second.end());
+    }
+
+    // Every node on the path of the key holds a matching prefix filter.
+    auto current = &root_;
+    for (size_t bit = 0; current != nullptr; ++bit)
+    {
+        out.insert(current->members.begin(), current->members.end());
+
+        if (bit == key.size())
+            break;
+
+        current = current->children[key[bit] ? 1 : 0].get();
+    }
+}
+
+template <typename Subscriber, typename Compare>
+std::vector<binary> subscription_index<Subscriber, Compare>::filters(
+    const Subscriber& subscriber) const
+{
+    const auto it = filters_.find(subscriber);
+    return it == filters_.end() ? std::vector<binary>{} : it->second;
+}
+
+template <typename Subscriber, typename Compare>
+size_t subscription_index<Subscriber, Compare>::size() const
+{
+    return filters_.size();
+}
+
+template <typename Subscriber, typename Compare>
+bool subscription_index<Subscriber, Compare>::empty() const
+{
+    return filters_.empty();
+}
+
+// private
+template <typename Subscriber, typename Compare>
+void subscription_index<Subscriber, Compare>::erase(const binary& filter,
+    const Subscriber& subscriber)
+{
+    if (filter.size() == exact_bits_)
+    {
+        const auto it = exact_.find(filter.blocks());
+        if (it == exact_.end())
+            return;
+
+        it->second.erase(subscriber);
+        if (it->second.empty())
+            exact_.erase(it);
+
+        return;
+    }
+
+    // Record the path so that emptied branches can be pruned.
+    std::vector<node*> path{ &root_ };
+    for (size_t bit = 0; bit < filter.size(); ++bit)
+    {
+        const auto child = path.back()->children[filter[bit] ? 1 : 0].get();
+        if (child == nullptr)
+            return;
+
+        path.push_back(child);
+    }
+
+    path.back()->members.erase(subscriber);
+
+    for (auto depth = filter.size(); depth > 0; --depth)
+    {
+        const auto current = path[depth];
+        if (!current->members.empty() || current->children[0] ||
+            current->children[1])
+            break;
+
+        path[depth - 1]->children[filter[depth - 1] ? 1 : 0].reset();
+    }
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -26,6 +26,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <UChain/bitcoin/utility/asio.hpp>
 #include <UChain/bitcoin/utility/assert.hpp>
 #include <UChain/bitcoin/utility/dispatcher.hpp>
@@ -78,11 +79,16 @@ public:
     /// Invoke all handlers sequentially (non-blocking).
     void relay(Args... args);
 
+    /// Invoke the handlers of the specified keys sequentially (non-blocking).
+    /// Keys that are not subscribed are ignored.
+    void relay_to(const std::vector<Key>& keys, Args... args);
+
 private:
     typedef struct { handler notify; asio::time_point expires; } value;
     typedef std::unordered_map<Key, value> map;
 
     void do_invoke(Args... args);
+    void do_invoke_to(const std::vector<Key>& keys, Args... args);
 
     const size_t limit_;
     bool stopped_;
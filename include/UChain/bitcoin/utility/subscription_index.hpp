@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_SUBSCRIPTION_INDEX_HPP
+#define UC_SUBSCRIPTION_INDEX_HPP
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <UChain/bitcoin/define.hpp>
+#include <UChain/bitcoin/utility/binary.hpp>
+#include <UChain/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/// This class is not thread safe.
+/// Index of subscribers by binary prefix filter. Filters of the exact key
+/// width are kept in a hash map, all other filters in a bitwise trie, so
+/// a lookup costs one hash probe plus a walk of at most key-width nodes and
+/// never visits a subscriber that does not match.
+template <typename Subscriber, typename Compare = std::less<Subscriber>>
+class subscription_index
+{
+public:
+    typedef std::set<Subscriber, Compare> subscribers;
+
+    /// Construct an index for keys of the given width in bits.
+    subscription_index(size_t exact_bits);
+
+    /// Add the subscriber, an empty filter matches every key.
+    void add(const binary& filter, const Subscriber& subscriber);
+
+    /// Remove the subscriber from the filter.
+    void remove(const binary& filter, const Subscriber& subscriber);
+
+    /// Remove the subscriber from every filter.
+    void remove(const Subscriber& subscriber);
+
+    /// Add each subscriber with a filter that is a prefix of key to out.
+    void find(const binary& key, subscribers& out) const;
+
+    /// The filters of the subscriber, empty if not subscribed.
+    std::vector<binary> filters(const Subscriber& subscriber) const;
+
+    /// The number of subscribers.
+    size_t size() const;
+    bool empty() const;
+
+private:
+    struct node
+    {
+        subscribers members;
+        std::unique_ptr<node> children[2];
+    };
+
+    struct chunk_hash
+    {
+        size_t operator()(const data_chunk& value) const;
+    };
+
+    typedef std::unordered_map<data_chunk, subscribers, chunk_hash> exact_map;
+    typedef std::map<Subscriber, std::vector<binary>, Compare> filter_map;
+
+    void erase(const binary& filter, const Subscriber& subscriber);
+
+    const size_t exact_bits_;
+    exact_map exact_;
+    node root_;
+    filter_map filters_;
+};
+
+} // namespace libbitcoin
+
+#include <UChain/bitcoin/impl/utility/subscription_index.ipp>
+
+#endif
@@ -23,6 +23,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <UChain/bitcoin/define.hpp>
 #include <UChain/bitcoin/math/elliptic_curve.hpp>
 #include <UChain/bitcoin/utility/data.hpp>
@@ -38,6 +39,8 @@ class BC_API hd_private
   : public hd_public
 {
 public:
+    typedef std::vector<hd_private> list;
+
     static const uint64_t mainnet;
 
     static inline uint32_t to_prefix(uint64_t prefixes)
@@ -86,6 +89,12 @@ public:
     hd_private derive_private(uint32_t index) const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Derive the children [first, first + count) of this key.
+    /// The parent fingerprint is computed once and the children are derived
+    /// concurrently, each child carrying its compressed public point.
+    /// Returns an empty list if any child is invalid.
+    list derive_private(uint32_t first, uint32_t count) const;
+
 private:
     /// Factories.
     static hd_private from_seed(data_slice seed, uint64_t prefixes);
@@ -101,6 +110,9 @@ private:
     hd_private(const ec_secret& secret, const hd_chain_code& chain_code,
         const hd_lineage& lineage);
 
+    /// Helpers.
+    hd_private derive_child(uint32_t index, uint32_t fingerprint) const;
+
     /// Members.
     /// This should be const, apart from the need to implement assignment.
     ec_secret secret_;
@@ -24,8 +24,8 @@
 #include <UChain/blockchain/block_chain.hpp>
 #include <UChain/blockchain/block_chain_impl.hpp>
 #include <UChain/blockchain/block_detail.hpp>
-#include <UChain/blockchain/block_fetcher.hpp>
 #include <UChain/blockchain/define.hpp>
+#include <UChain/blockchain/header_index.hpp>
 #include <UChain/blockchain/organizer.hpp>
 #include <UChain/blockchain/orphan_pool.hpp>
 #include <UChain/blockchain/settings.hpp>
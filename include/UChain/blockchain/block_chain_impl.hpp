@@ -30,6 +30,7 @@
 #include <UChain/database.hpp>
 #include <UChain/blockchain/block_chain.hpp>
 #include <UChain/blockchain/define.hpp>
+#include <UChain/blockchain/header_index.hpp>
 #include <UChain/blockchain/organizer.hpp>
 #include <UChain/blockchain/settings.hpp>
 #include <UChain/blockchain/simple_chain.hpp>
@@ -45,11 +46,18 @@ namespace blockchain {
 
 typedef console_result operation_result;
 
+/// The block_chain queries that reach the network are run on a dedicated
+/// read pool, so slow reads never hold a channel strand or the caller.
 /// The simple_chain interface portion of this class is not thread safe.
 class BCB_API block_chain_impl
   : public block_chain, public simple_chain
 {
 public:
+    typedef handle2<chain::transaction::list, hash_list>
+        transactions_fetch_handler;
+    typedef handle1<std::vector<history_compact::list>>
+        histories_fetch_handler;
+
     block_chain_impl(threadpool& pool,
         const blockchain::settings& chain_settings,
         const database::settings& database_settings);
@@ -97,6 +105,10 @@ public:
     /// Get the header of the block at the given height.
     bool get_header(chain::header& out_header, uint64_t height) const;
 
+    /// Get the indexed header fields of the block at the given height.
+    bool get_header_entry(header_index::entry& out_entry,
+        uint64_t height) const;
+
     /// Get the height of the block with the given hash.
     bool get_height(uint64_t& out_height, const hash_digest& block_hash) const;
 
@@ -111,6 +123,13 @@ public:
     bool get_transaction(chain::transaction& out_transaction,
         uint64_t& out_block_height, const hash_digest& transaction_hash) const;
 
+    /// Get the transactions of the given hashes and their block heights,
+    /// reading concurrently on the prefetch pool, blocking until complete.
+    /// Transactions that are not found are omitted from the result.
+    /// Only for use by block verification, within the write section.
+    void get_transactions(transaction_map& out_transactions,
+        const hash_list& hashes);
+
     /// Import a block to the blockchain.
     bool import(chain::block::ptr block, uint64_t height);
 
@@ -181,6 +200,10 @@ public:
     void fetch_transaction(const hash_digest& hash,
         transaction_fetch_handler handler);
 
+    /// fetch many transactions in one read, returning the hashes not found.
+    void fetch_transactions(const hash_list& hashes,
+        transactions_fetch_handler handler);
+
     /// fetch height and offset within block of transaction by hash.
     void fetch_transaction_index(const hash_digest& hash,
         transaction_index_fetch_handler handler);
@@ -196,6 +219,10 @@ public:
     bool fetch_history(const wallet::payment_address& address,
         uint64_t limit, uint64_t from_height, history_compact::list& history);
 
+    /// fetch the histories of many addresses in one read, aligned with them.
+    void fetch_histories(const std::vector<wallet::payment_address>& addresses,
+        uint64_t limit, uint64_t from_height, histories_fetch_handler handler);
+
 
     history::list get_address_history(const wallet::payment_address& addr, bool add_memory_pool = false);
 
@@ -336,6 +363,8 @@ public:
     organizer& get_organizer();
     bool get_transaction(const hash_digest& hash,
         chain::transaction& tx, uint64_t& tx_height);
+    bool get_output(const chain::output_point& point,
+        chain::output& output, bool& is_coinbase);
     bool get_transaction_callback(const hash_digest& hash,
     std::function<void(const code&, const chain::transaction&)> handler);
     bool get_history_callback(const payment_address& address,
@@ -375,10 +404,13 @@ private:
         block_store_handler handler);
 
     ////void fetch_ordered(perform_read_functor perform_read);
-    ////void fetch_parallel(perform_read_functor perform_read);
+    void fetch_parallel(perform_read_functor perform_read);
     void fetch_serial(perform_read_functor perform_read);
     bool stopped() const;
 
+    // Extend the header index with stored blocks up to the first gap.
+    void index_headers();
+
     std::string get_token_symbol_from_asset_data(const asset_data& data);
 
 private:
@@ -387,9 +419,12 @@ private:
 
     // These are thread safe.
     organizer organizer_;
-    ////dispatcher read_dispatch_;
+    threadpool read_pool_;
+    threadpool prefetch_pool_;
+    dispatcher read_dispatch_;
     ////dispatcher write_dispatch_;
     blockchain::transaction_pool transaction_pool_;
+    header_index headers_;
 
     // This is protected by mutex.
     database::data_base database_;
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers 
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_BLOCKCHAIN_HEADER_INDEX_HPP
+#define UC_BLOCKCHAIN_HEADER_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <UChain/bitcoin.hpp>
+#include <UChain/blockchain/define.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+/// This class is thread safe.
+/// A contiguous memory index of the headers of the block chain, from the
+/// genesis block up to the first gap. Only the fields used for contextual
+/// validation and locators are kept, along with the cumulative chain work.
+class BCB_API header_index
+{
+public:
+    struct entry
+    {
+        hash_digest hash;
+        u256 bits;
+        uint32_t timestamp;
+        uint32_t version;
+
+        /// The work of the chain from genesis through this block.
+        u256 work;
+    };
+
+    /// Append the header, false if the height is not the index size.
+    bool push(const chain::header& header, size_t height);
+
+    /// Remove the entries at or above the given height.
+    void pop_from(size_t height);
+
+    /// Remove all entries.
+    void clear();
+
+    /// The number of entries, which is the height of the first gap.
+    size_t size() const;
+
+    /// Get the entry at the given height, false if not indexed.
+    bool get(entry& out_entry, size_t height) const;
+
+    /// Get the block hash at the given height, false if not indexed.
+    bool get_hash(hash_digest& out_hash, size_t height) const;
+
+    /// Get the work of the blocks from height through the top of the index.
+    bool get_work(u256& out_work, size_t height) const;
+
+private:
+    typedef std::vector<entry> entries;
+
+    // This is protected by mutex.
+    entries entries_;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace blockchain
+} // namespace libbitcoin
+
+#endif
@@ -22,8 +22,11 @@
 #define UC_BLOCKCHAIN_orphan_pool_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <map>
 #include <memory>
-#include <boost/circular_buffer.hpp>
+#include <set>
+#include <unordered_map>
 #include <UChain/bitcoin.hpp>
 #include <UChain/blockchain/define.hpp>
 #include <UChain/blockchain/block_detail.hpp>
@@ -32,7 +35,8 @@ namespace libbitcoin {
 namespace blockchain {
 
 /// This class is thread safe.
-/// An unordered memory pool for orphan blocks.
+/// A memory pool for orphan blocks, indexed by hash and by previous hash.
+/// When full the oldest orphan is evicted.
 class BCB_API orphan_pool
 {
 public:
@@ -52,6 +56,12 @@ public:
     /// Get the longest connected chain of orphans after 'end'.
     block_detail::list trace(block_detail::ptr end) const;
 
+    /// Get the orphans that directly extend the block of the given hash.
+    block_detail::list children(const hash_digest& hash) const;
+
+    /// The number of orphans in the pool.
+    size_t size() const;
+
     /// Get the set of unprocessed orphans.
     block_detail::list unprocessed() const;
 
@@ -59,18 +69,22 @@ public:
     block_detail::ptr delete_pending_block(const hash_digest& needed_block);
 
 private:
-//    typedef boost::circular_buffer<block_detail::ptr> buffer;
-    typedef std::vector<block_detail::ptr> buffer;
-    typedef buffer::const_iterator const_iterator;
-    typedef buffer::const_reverse_iterator const_reverse_iterator;
+    struct entry
+    {
+        block_detail::ptr block;
+        uint64_t sequence;
+    };
 
     bool exists(const hash_digest& hash) const;
-    bool exists(const chain::header& header) const;
-    const_iterator find(buffer::const_iterator begin, const hash_digest& hash) const;
-    const_reverse_iterator rfind(buffer::const_reverse_iterator begin, const hash_digest& hash) const;
-
-    // The buffer is protected by mutex.
-    buffer buffer_;
+    void erase(const hash_digest& hash);
+    void evict();
+
+    // These are protected by mutex.
+    const size_t capacity_;
+    uint64_t sequence_;
+    std::unordered_map<hash_digest, entry> blocks_;
+    std::unordered_multimap<hash_digest, hash_digest> children_;
+    std::map<uint64_t, block_detail::ptr> arrivals_;
     mutable upgrade_mutex mutex_;
 
     std::multimap<hash_digest, block_detail::ptr> pending_blocks_;
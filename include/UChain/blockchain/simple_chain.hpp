@@ -22,9 +22,12 @@
 #define UC_BLOCKCHAIN_SIMPLE_CHAIN_HPP
 
 #include <cstddef>
+#include <unordered_map>
+#include <utility>
 #include <UChain/bitcoin.hpp>
 #include <UChain/blockchain/define.hpp>
 #include <UChain/blockchain/block_detail.hpp>
+#include <UChain/blockchain/header_index.hpp>
 
 namespace libbitcoin {
 namespace blockchain {
@@ -36,6 +39,9 @@ namespace blockchain {
 class BCB_API simple_chain
 {
 public:
+    typedef std::unordered_map<hash_digest,
+        std::pair<chain::transaction, uint64_t>> transaction_map;
+
     /// Return the first and last gaps in the blockchain, or false if none.
     virtual bool get_gap_range(uint64_t& out_first,
         uint64_t& out_last) const = 0;
@@ -52,6 +58,10 @@ public:
     virtual bool get_header(chain::header& out_header,
         uint64_t height) const = 0;
 
+    /// Get the indexed header fields of the block at the given height.
+    virtual bool get_header_entry(header_index::entry& out_entry,
+        uint64_t height) const = 0;
+
     /// Get the height of the block with the given hash.
     virtual bool get_height(uint64_t& out_height,
         const hash_digest& block_hash) const = 0;
@@ -68,6 +78,13 @@ public:
         uint64_t& out_block_height,
         const hash_digest& transaction_hash) const = 0;
 
+    /// Get the transactions of the given hashes and their block heights,
+    /// omitting those not found. The reads do not take the sequence lock,
+    /// so this may only be called while the caller holds the write section
+    /// (during block verification), when no write can overlap the reads.
+    virtual void get_transactions(transaction_map& out_transactions,
+        const hash_list& hashes) = 0;
+
     /// Import a block for the given height.
     virtual bool import(chain::block::ptr block, uint64_t height) = 0;
 
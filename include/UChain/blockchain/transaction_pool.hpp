@@ -24,6 +24,7 @@
 #include <atomic>
 #include <cstddef>
 #include <functional>
+#include <unordered_map>
 #include <boost/circular_buffer.hpp>
 #include <UChain/bitcoin.hpp>
 #include <UChain/blockchain/define.hpp>
@@ -105,13 +106,23 @@ protected:
 
     bool stopped();
     const_iterator find(const hash_digest& tx_hash) const;
+    bool is_spent(const chain::output_point& outpoint) const;
+    void erase(buffer::iterator it);
 
     bool handle_reorganized(const code& ec, size_t fork_point,
         const block_list& new_blocks, const block_list& replaced_blocks);
     void handle_validated(const code& ec, transaction_ptr tx,
-        const indexes& unconfirmed, validate_handler handler);
-
-    void do_validate(transaction_ptr tx, validate_handler handler);
+        const indexes& unconfirmed, bool deferrable,
+        validate_handler handler);
+
+    void do_validate(transaction_ptr tx, bool retried,
+        validate_handler handler);
+    bool is_parent_validating(const code& ec, transaction_ptr tx,
+        const indexes& unconfirmed) const;
+    bool defer_validated(const code& ec, transaction_ptr tx,
+        const indexes& unconfirmed, bool deferrable,
+        validate_handler handler);
+    void finish_validated(transaction_ptr tx);
     void do_store(const code& ec, transaction_ptr tx,
         const indexes& unconfirmed, confirm_handler handle_confirm,
         validate_handler handle_validate);
@@ -135,7 +146,8 @@ protected:
     void delete_package(transaction_ptr tx, const code& ec);
     bool delete_single(const hash_digest& tx_hash, const code& ec);
 
-    // The buffer is protected by non-concurrent dispatch.
+    // The buffer is changed only by non-concurrent dispatch, under mutex so
+    // that concurrent validation may read it.
     buffer buffer_;
     std::atomic<bool> stopped_;
 
@@ -143,7 +155,7 @@ private:
     // Unsafe methods limited to friend caller.
     friend class validate_transaction;
 
-    // These methods are NOT thread safe.
+    // These methods are safe concurrent with non-concurrent dispatch.
     bool is_in_pool(const hash_digest& tx_hash) const;
     bool is_spent_in_pool(transaction_ptr tx) const;
     bool is_spent_in_pool(const chain::transaction& tx) const;
@@ -157,6 +169,19 @@ private:
     transaction_pool_index index_;
     transaction_subscriber::ptr subscriber_;
     const bool maintain_consistency_;
+
+    // Transactions being validated, counted by hash as the same tx may be
+    // validated concurrently (protected by mutex), and those waiting on a
+    // parent among them (protected by ordered dispatch).
+    struct deferred
+    {
+        transaction_ptr tx;
+        validate_handler handler;
+    };
+
+    std::unordered_map<hash_digest, size_t> validating_;
+    std::unordered_multimap<hash_digest, deferred> waiting_;
+    mutable shared_mutex mutex_;
 };
 
 } // namespace blockchain
@@ -86,6 +86,7 @@ protected:
         size_t index_in_parent, size_t input_index) const = 0;
 
     // These have default implementations that can be overriden.
+    virtual void prefetch_transactions(const hash_list& tx_hashes) const;
     virtual bool connect_input(size_t index_in_parent,
         const chain::transaction& current_tx, size_t input_index,
         uint64_t& value_in, size_t& total_sigops) const;
@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <vector>
 #include <UChain/bitcoin.hpp>
+#include <UChain/blockchain/header_index.hpp>
 #include <UChain/blockchain/simple_chain.hpp>
 #include <UChain/blockchain/validate_block.hpp>
 
@@ -59,6 +60,8 @@ protected:
     uint64_t actual_time_span(size_t interval) const;
     versions preceding_block_versions(size_t maximum) const;
     chain::header fetch_block(size_t fetch_height) const;
+    header_index::entry fetch_header(size_t fetch_height) const;
+    void prefetch_transactions(const hash_list& tx_hashes) const;
     bool fetch_transaction(chain::transaction& tx, size_t& tx_height,
         const hash_digest& tx_hash) const;
     bool is_output_spent(const chain::output_point& outpoint) const;
@@ -77,6 +80,9 @@ private:
     size_t fork_index_;
     size_t orphan_index_;
     const block_detail::list& orphan_chain_;
+
+    // Previous transactions of the block, resolved below the fork point.
+    mutable simple_chain::transaction_map prefetched_;
 };
 
 } // namespace blockchain
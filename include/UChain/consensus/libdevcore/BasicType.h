@@ -20,7 +20,7 @@ public:
     static HeaderAux* get();
     static h256 seedHash(libbitcoin::chain::header& _bi);
     static h256 hashHead(libbitcoin::chain::header& _bi);
-    static h256 boundary(libbitcoin::chain::header& _bi) { auto d = _bi.bits; return d ? (h256)u256(((bigint(1) << 255)-bigint(1) +(bigint(1) << 255) ) / d) : h256(); }
+    static h256 boundary(libbitcoin::chain::header& _bi) { auto const& d = _bi.bits; return d ? (h256)(std::numeric_limits<u256>::max() / d) : h256(); }
     static u256 calculateDifficulty(libbitcoin::chain::header& _bi, libbitcoin::chain::header& _parent);
     static uint64_t number(h256& _seedHash);
     static uint64_t cacheSize(libbitcoin::chain::header& _header);
@@ -18,6 +18,7 @@
 #include <UChain/database/data_base.hpp>
 #include <UChain/database/define.hpp>
 #include <UChain/database/settings.hpp>
+#include <UChain/database/snapshot.hpp>
 #include <UChain/database/version.hpp>
 #include <UChain/database/databases/block_database.hpp>
 #include <UChain/database/databases/history_database.hpp>
@@ -28,6 +29,7 @@
 #include <UChain/database/memory/allocator.hpp>
 #include <UChain/database/memory/memory.hpp>
 #include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/memory/read_guard.hpp>
 #include <UChain/database/primitives/hash_table_header.hpp>
 #include <UChain/database/primitives/record_hash_table.hpp>
 #include <UChain/database/primitives/record_list.hpp>
@@ -143,6 +143,11 @@ public:
     static bool initialize(const path& prefix, const chain::block& genesis);
     /// If database exists then upgrades to version 63.
     static bool upgrade_version_63(const path& prefix);
+    /// If database exists at the preceding version then upgrades it to
+    /// version 2, completing an interrupted upgrade if there is one.
+    static bool upgrade_version_2(const settings& settings);
+    /// The transaction table of an upgrade that is complete but not swapped in.
+    static path upgraded_path(const store& paths);
 
     static bool touch_file(const path& file_path);
     static void write_metadata(const path& metadata_path, data_base::db_metadata& metadata);
@@ -309,8 +314,10 @@ public:
    /* begin store token info into  database */
 
 protected:
-    data_base(const store& paths, size_t history_height, size_t stealth_height);
-    data_base(const path& prefix, size_t history_height, size_t stealth_height);
+    data_base(const store& paths, size_t history_height, size_t stealth_height,
+        size_t reservation=0);
+    data_base(const path& prefix, size_t history_height, size_t stealth_height,
+        size_t reservation=0);
 
 private:
     typedef chain::input::list inputs;
@@ -322,6 +329,8 @@ private:
     static bool initialize_tokens(const path& prefix);
     static bool initialize_certs(const path& prefix);
     static bool initialize_cards(const path& prefix);
+    static bool upgrade_transactions(const settings& settings);
+    static bool replace_transactions(const settings& settings);
 
     static void uninitialize_lock(const path& lock);
     static file_lock initialize_lock(const path& lock);
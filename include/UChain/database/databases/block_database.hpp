@@ -45,7 +45,7 @@ public:
     /// Construct the database.
     block_database(const boost::filesystem::path& map_filename,
         const boost::filesystem::path& index_filename,
-        std::shared_ptr<shared_mutex> mutex=nullptr);
+        std::shared_ptr<shared_mutex> mutex=nullptr, size_t reservation=0);
 
     /// Close the database (all threads must first be stopped).
     ~block_database();
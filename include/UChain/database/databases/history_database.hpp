@@ -52,7 +52,7 @@ public:
     /// Construct the database.
     history_database(const boost::filesystem::path& lookup_filename,
         const boost::filesystem::path& rows_filename,
-        std::shared_ptr<shared_mutex> mutex=nullptr);
+        std::shared_ptr<shared_mutex> mutex=nullptr, size_t reservation=0);
 
     /// Close the database (all threads must first be stopped).
     ~history_database();
@@ -49,7 +49,7 @@ class BCD_API spend_database
 public:
     /// Construct the database.
     spend_database(const boost::filesystem::path& filename,
-        std::shared_ptr<shared_mutex> mutex=nullptr);
+        std::shared_ptr<shared_mutex> mutex=nullptr, size_t reservation=0);
 
     /// Close the database (all threads must first be stopped).
     ~spend_database();
@@ -39,7 +39,7 @@ public:
 
     /// Construct the database.
     stealth_database(const boost::filesystem::path& rows_filename,
-        std::shared_ptr<shared_mutex> mutex=nullptr);
+        std::shared_ptr<shared_mutex> mutex=nullptr, size_t reservation=0);
 
     /// Close the database (all threads must first be stopped).
     ~stealth_database();
@@ -43,7 +43,7 @@ class BCD_API transaction_database
 public:
     /// Construct the database.
     transaction_database(const boost::filesystem::path& map_filename,
-        std::shared_ptr<shared_mutex> mutex=nullptr);
+        std::shared_ptr<shared_mutex> mutex=nullptr, size_t reservation=0);
 
     /// Close the database (all threads must first be stopped).
     ~transaction_database();
@@ -25,6 +25,7 @@
 #include <stdexcept>
 #include <UChain/bitcoin.hpp>
 #include <UChain/database/memory/memory.hpp>
+#include <UChain/database/memory/read_guard.hpp>
 
 namespace libbitcoin {
 namespace database {
@@ -102,9 +103,9 @@ ValueType hash_table_header<IndexType, ValueType>::read(IndexType index) const
     // This is not runtime safe but test is avoided as an optimization.
     BITCOIN_ASSERT(index < buckets_);
 
-    // The accessor must remain in scope until the end of the block.
-    const auto memory = file_.access();
-    const auto value_address = REMAP_ADDRESS(memory) + item_position(index);
+    // The guard must remain in scope until the end of the block.
+    const read_guard memory(file_);
+    const auto value_address = memory.buffer() + item_position(index);
 
     // Critical Section
     ///////////////////////////////////////////////////////////////////////////
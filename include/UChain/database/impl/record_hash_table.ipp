@@ -24,6 +24,7 @@
 #include <string>
 #include <UChain/bitcoin.hpp>
 #include <UChain/database/memory/memory.hpp>
+#include <UChain/database/memory/read_guard.hpp>
 #include "record_row.ipp"
 #include "remainder.ipp"
 
@@ -60,29 +61,19 @@ void record_hash_table<KeyType>::store(const KeyType& key,
 template <typename KeyType>
 const memory_ptr record_hash_table<KeyType>::find(const KeyType& key) const
 {
-    // Find start item...
-    auto current = read_bucket_value(key);
-
-    // Iterate through list...
-    while (current != header_.empty)
+    auto found = header_.empty;
+    const auto first = [&found](array_index index)
     {
-        const record_row<KeyType> item(manager_, current);
+        found = index;
+        return false;
+    };
 
-        // Found, return data.
-        if (item.compare(key))
-            return item.data();
+    walk(read_bucket_value(key), &key, first);
 
-        const auto previous = current;
-        current = item.next_index();
+    if (found == header_.empty)
+        return nullptr;
 
-        // This may otherwise produce an infinite loop here.
-        // It indicates that a write operation has interceded.
-        // So we must return gracefully vs. looping forever.
-        if (previous == current)
-            return nullptr;
-    }
-
-    return nullptr;
+    return record_row<KeyType>(manager_, found).data();
 }
 
 
@@ -90,28 +81,24 @@ const memory_ptr record_hash_table<KeyType>::find(const KeyType& key) const
 template <typename KeyType>
 std::shared_ptr<std::vector<memory_ptr>> record_hash_table<KeyType>::find(array_index index) const
 {
-    auto vec_memo = std::make_shared<std::vector<memory_ptr>>();
     // find first item
     auto current = header_.read(index);
     static_assert(sizeof(current) == sizeof(array_index), "Invalid size");
 
-    // Iterate through list...
-    while (current != header_.empty)
+    std::vector<array_index> indexes;
+    const auto all = [&indexes](array_index index)
     {
-        const record_row<KeyType> item(manager_, current);
+        indexes.push_back(index);
+        return true;
+    };
 
-        // Found.
-        vec_memo->push_back(item.data());
+    walk(current, nullptr, all);
 
-        const auto previous = current;
-        current = item.next_index();
+    auto vec_memo = std::make_shared<std::vector<memory_ptr>>();
+    vec_memo->reserve(indexes.size());
 
-        // This may otherwise produce an infinite loop here.
-        // It indicates that a write operation has interceded.
-        // So we must return gracefully vs. looping forever.
-        if (previous == current)
-            break;
-    }
+    for (const auto index: indexes)
+        vec_memo->push_back(record_row<KeyType>(manager_, index).data());
 
     return vec_memo;
 }
@@ -185,6 +172,37 @@ void record_hash_table<KeyType>::link(const KeyType& key,
     header_.write(bucket_index(key), begin);
 }
 
+template <typename KeyType>
+template <typename Visitor>
+void record_hash_table<KeyType>::walk(array_index current,
+    const KeyType* key, Visitor visit) const
+{
+    static BC_CONSTEXPR auto key_size = record_row<KeyType>::key_size;
+
+    // The guard must remain in scope until the end of the block.
+    const read_guard memory(manager_.file());
+
+    // Iterate through list...
+    while (current != header_.empty)
+    {
+        // Key data is at the start, next index is after key data.
+        const auto row = manager_.get(memory, current);
+
+        if ((key == nullptr || std::equal(key->begin(), key->end(), row)) &&
+            !visit(current))
+            return;
+
+        const auto previous = current;
+        current = from_little_endian_unsafe<array_index>(row + key_size);
+
+        // This may otherwise produce an infinite loop here.
+        // It indicates that a write operation has interceded.
+        // So we must return gracefully vs. looping forever.
+        if (previous == current)
+            return;
+    }
+}
+
 template <typename KeyType>
 template <typename ListItem>
 void record_hash_table<KeyType>::release(const ListItem& item,
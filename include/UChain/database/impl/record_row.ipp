@@ -63,7 +63,6 @@ private:
 
     array_index index_;
     record_manager& manager_;
-    mutable shared_mutex mutex_;
 };
 
 template <typename KeyType>
@@ -90,13 +89,9 @@ array_index record_row<KeyType>::create(const KeyType& key,
     auto serial = make_serializer(record);
     serial.write_data(key);
 
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    unique_lock lock(mutex_);
     serial.template write_little_endian<array_index>(next);
 
     return index_;
-    ///////////////////////////////////////////////////////////////////////////
 }
 
 template <typename KeyType>
@@ -120,11 +115,7 @@ array_index record_row<KeyType>::next_index() const
     const auto memory = raw_next_data();
     const auto next_address = REMAP_ADDRESS(memory);
 
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    shared_lock lock(mutex_);
     return from_little_endian_unsafe<array_index>(next_address);
-    ///////////////////////////////////////////////////////////////////////////
 }
 
 template <typename KeyType>
@@ -133,11 +124,7 @@ void record_row<KeyType>::write_next_index(array_index next)
     const auto memory = raw_next_data();
     auto serial = make_serializer(REMAP_ADDRESS(memory));
 
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    unique_lock lock(mutex_);
     serial.template write_little_endian<array_index>(next);
-    ///////////////////////////////////////////////////////////////////////////
 }
 
 template <typename KeyType>
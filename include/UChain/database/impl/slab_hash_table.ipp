@@ -23,6 +23,7 @@
 
 #include <UChain/bitcoin.hpp>
 #include <UChain/database/memory/memory.hpp>
+#include <UChain/database/memory/read_guard.hpp>
 #include "remainder.ipp"
 #include "slab_row.ipp"
 
@@ -88,96 +89,58 @@ file_offset slab_hash_table<KeyType>::restore(const KeyType& key,
 template <typename KeyType>
 const memory_ptr slab_hash_table<KeyType>::find(const KeyType& key) const
 {
-    // Find start item...
-    auto current = read_bucket_value(key);
-
-    // Iterate through list...
-    while (current != header_.empty)
+    auto found = header_.empty;
+    const auto first = [&found](file_offset position)
     {
-        const slab_row<KeyType> item(manager_, current);
-
-        if(item.out_of_memory())
-            break;
+        found = position;
+        return false;
+    };
 
-        // Found.
-        if (item.compare(key))
-            return item.data();
+    walk(read_bucket_value(key), &key, first);
 
-        const auto previous = current;
-        current = item.next_position();
+    if (found == header_.empty)
+        return nullptr;
 
-        // This may otherwise produce an infinite loop here.
-        // It indicates that a write operation has interceded.
-        // So we must return gracefully vs. looping forever.
-        if (previous == current)
-            return nullptr;
-    }
-
-    return nullptr;
+    return slab_row<KeyType>(manager_, found).data();
 }
 
 // This is limited to returning the last of multiple matching key values.
 template <typename KeyType>
 const memory_ptr slab_hash_table<KeyType>::rfind(const KeyType& key) const
 {
-    memory_ptr ret;
-    // Find start item...
-    auto current = read_bucket_value(key);
-
-    // Iterate through list...
-    while (current != header_.empty)
+    auto found = header_.empty;
+    const auto last = [&found](file_offset position)
     {
-        const slab_row<KeyType> item(manager_, current);
-
-        if(item.out_of_memory())
-            return nullptr;
-
-        // Found.
-        if (item.compare(key))
-            ret = item.data();
+        found = position;
+        return true;
+    };
 
-        const auto previous = current;
-        current = item.next_position();
+    walk(read_bucket_value(key), &key, last);
 
-        // This may otherwise produce an infinite loop here.
-        // It indicates that a write operation has interceded.
-        // So we must return gracefully vs. looping forever.
-        if (previous == current)
-            break;
-    }
+    if (found == header_.empty)
+        return nullptr;
 
-    return ret;
+    return slab_row<KeyType>(manager_, found).data();
 }
 
 // This is returning all of multiple matching key values.
 template <typename KeyType>
 std::vector<memory_ptr> slab_hash_table<KeyType>::finds(const KeyType& key) const
 {
-    std::vector<memory_ptr> ret;
-    // Find start item...
-    auto current = read_bucket_value(key);
-
-    // Iterate through list...
-    while (current != header_.empty)
+    std::vector<file_offset> positions;
+    const auto all = [&positions](file_offset position)
     {
-        const slab_row<KeyType> item(manager_, current);
-
-        if(item.out_of_memory())
-            break;
+        positions.push_back(position);
+        return true;
+    };
 
-        // Found.
-        if (item.compare(key))
-            ret.push_back(item.data());
+    walk(read_bucket_value(key), &key, all);
 
-        const auto previous = current;
-        current = item.next_position();
+    std::vector<memory_ptr> ret;
+    ret.reserve(positions.size());
 
-        // This may otherwise produce an infinite loop here.
-        // It indicates that a write operation has interceded.
-        // So we must return gracefully vs. looping forever.
-        if (previous == current)
-            break;
-    }
+    for (const auto position: positions)
+        ret.push_back(slab_row<KeyType>(manager_, position).data());
 
     return ret;
 }
@@ -187,31 +150,24 @@ std::vector<memory_ptr> slab_hash_table<KeyType>::finds(const KeyType& key) cons
 template <typename KeyType>
 std::shared_ptr<std::vector<memory_ptr>> slab_hash_table<KeyType>::find(uint64_t index) const
 {
-    auto vec_memo = std::make_shared<std::vector<memory_ptr>>();
     // find first item
     auto current = header_.read(index);
     static_assert(sizeof(current) == sizeof(file_offset), "Invalid size");
 
-    // Iterate through list...
-    while (current != header_.empty)
+    std::vector<file_offset> positions;
+    const auto all = [&positions](file_offset position)
     {
-        const slab_row<KeyType> item(manager_, current);
+        positions.push_back(position);
+        return true;
+    };
 
-        if(item.out_of_memory())
-            break;
+    walk(current, nullptr, all);
 
-        // Found.
-        vec_memo->push_back(item.data());
+    auto vec_memo = std::make_shared<std::vector<memory_ptr>>();
+    vec_memo->reserve(positions.size());
 
-        const auto previous = current;
-        current = item.next_position();
-
-        // This may otherwise produce an infinite loop here.
-        // It indicates that a write operation has interceded.
-        // So we must return gracefully vs. looping forever.
-        if (previous == current)
-            break;
-    }
+    for (const auto position: positions)
+        vec_memo->push_back(slab_row<KeyType>(manager_, position).data());
 
     return vec_memo;
 }
@@ -290,6 +246,42 @@ void slab_hash_table<KeyType>::link(const KeyType& key,
     header_.write(bucket_index(key), begin);
 }
 
+template <typename KeyType>
+template <typename Visitor>
+void slab_hash_table<KeyType>::walk(file_offset current, const KeyType* key,
+    Visitor visit) const
+{
+    static BC_CONSTEXPR auto key_size = slab_row<KeyType>::key_size;
+    const auto payload_size = manager_.payload_size();
+
+    // The guard must remain in scope until the end of the block.
+    const read_guard memory(manager_.file());
+
+    // Iterate through list...
+    while (current != header_.empty)
+    {
+        // The chain crosses the end of the slabs.
+        if (current > payload_size)
+            return;
+
+        // Key data is at the start, next position is after key data.
+        const auto row = manager_.get(memory, current);
+
+        if ((key == nullptr || std::equal(key->begin(), key->end(), row)) &&
+            !visit(current))
+            return;
+
+        const auto previous = current;
+        current = from_little_endian_unsafe<file_offset>(row + key_size);
+
+        // This may otherwise produce an infinite loop here.
+        // It indicates that a write operation has interceded.
+        // So we must return gracefully vs. looping forever.
+        if (previous == current)
+            return;
+    }
+}
+
 template <typename KeyType>
 template <typename ListItem>
 void slab_hash_table<KeyType>::release(const ListItem& item,
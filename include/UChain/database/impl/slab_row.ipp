@@ -67,7 +67,6 @@ private:
 
     file_offset position_;
     slab_manager& manager_;
-    mutable shared_mutex mutex_;
 };
 
 template <typename KeyType>
@@ -97,13 +96,9 @@ file_offset slab_row<KeyType>::create(const KeyType& key,
     auto serial = make_serializer(key_data);
     serial.write_data(key);
 
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    unique_lock lock(mutex_);
     serial.template write_little_endian<file_offset>(next);
 
     return position_;
-    ///////////////////////////////////////////////////////////////////////////
 }
 
 template <typename KeyType>
@@ -127,11 +122,7 @@ file_offset slab_row<KeyType>::next_position() const
     const auto memory = raw_next_data();
     const auto next_address = REMAP_ADDRESS(memory);
 
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    shared_lock lock(mutex_);
     return from_little_endian_unsafe<file_offset>(next_address);
-    ///////////////////////////////////////////////////////////////////////////
 }
 
 template <typename KeyType>
@@ -140,11 +131,7 @@ void slab_row<KeyType>::write_next_position(file_offset next)
     const auto memory = raw_next_data();
     auto serial = make_serializer(REMAP_ADDRESS(memory));
 
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    unique_lock lock(mutex_);
     serial.template write_little_endian<file_offset>(next);
-    ///////////////////////////////////////////////////////////////////////////
 }
 
 template <typename KeyType>
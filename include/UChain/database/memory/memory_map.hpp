@@ -45,8 +45,13 @@ public:
     typedef std::shared_ptr<shared_mutex> mutex_ptr;
 
     /// Construct a database (start is currently called, may throw).
+    /// A nonzero reservation maps address space of that size, zero (the
+    /// default) maps only the file. Growth within the reservation extends the
+    /// file in place, so the base address does not move and readers are not
+    /// stalled by a remap.
     memory_map(const boost::filesystem::path& filename);
-    memory_map(const boost::filesystem::path& filename, mutex_ptr mutex);
+    memory_map(const boost::filesystem::path& filename, mutex_ptr mutex,
+        size_t reservation=0);
 
     /// Close the database.
     ~memory_map();
@@ -74,6 +79,8 @@ public:
     memory_ptr reserve(size_t size, size_t growth_ratio);
 
 private:
+    friend class read_guard;
+
     static size_t file_size(int file_handle);
     static int open_file(const boost::filesystem::path& filename);
     static bool handle_error(const std::string& context,
@@ -83,9 +90,11 @@ private:
     bool unmap();
     bool map(size_t size);
     bool remap(size_t size);
+    bool allocate(size_t size);
     bool truncate(size_t size);
     bool truncate_mapped(size_t size);
-    bool validate(size_t size);
+    bool validate(size_t size, size_t mapped);
+    size_t mapping_size(size_t size) const;
 
     void log_mapping();
     void log_resizing(size_t size);
@@ -94,6 +103,9 @@ private:
     // Optionally guard against concurrent remap.
     mutex_ptr remap_mutex_;
 
+    // Address space reserved for the map.
+    const size_t reservation_;
+
     // File system.
     const int file_handle_;
     const boost::filesystem::path filename_;
@@ -101,6 +113,7 @@ private:
     // Protected by internal mutex.
     uint8_t* data_;
     size_t file_size_;
+    size_t mapped_size_;
     size_t logical_size_;
     std::atomic<bool> closed_;
     std::atomic<bool> stopped_;
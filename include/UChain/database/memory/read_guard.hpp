@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers 
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_DATABASE_READ_GUARD_HPP
+#define UC_DATABASE_READ_GUARD_HPP
+
+#include <cstdint>
+#include <UChain/bitcoin.hpp>
+#include <UChain/database/define.hpp>
+#include <UChain/database/memory/memory_map.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// This class provides scoped remap safe read access to file-mapped memory.
+/// Unlike accessor it lives on the stack, so a lookup that walks many rows
+/// holds one shared remap lock and makes no heap allocation. The address
+/// must not be used outside of the scope of the guard, and no accessor may
+/// be obtained from the same file within that scope.
+class BCD_API read_guard
+{
+public:
+    read_guard(const memory_map& file);
+    ~read_guard();
+
+    /// This class is not copyable.
+    read_guard(const read_guard& other) = delete;
+    void operator=(const read_guard&) = delete;
+
+    /// Get the address of the start of the mapped memory.
+    uint8_t* buffer() const;
+
+private:
+#ifdef REMAP_SAFETY
+    shared_mutex& mutex_;
+#endif
+    uint8_t* data_;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
@@ -88,6 +88,12 @@ private:
     // Link a new chain into the bucket header.
     void link(const KeyType& key, const array_index begin);
 
+    // Visit the index of each row of the chain from current that matches
+    // the key (each row if null) until the visitor returns false. The chain
+    // is read under one remap read lock, without allocation.
+    template <typename Visitor>
+    void walk(array_index current, const KeyType* key, Visitor visit) const;
+
     // Release node from linked chain.
     template <typename ListItem>
     void release(const ListItem& item, const file_offset previous);
@@ -28,6 +28,7 @@
 #include <UChain/database/define.hpp>
 #include <UChain/database/memory/memory.hpp>
 #include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/memory/read_guard.hpp>
 
 namespace libbitcoin {
 namespace database {
@@ -69,6 +70,13 @@ public:
     /// Return memory object for the record at the specified index.
     const memory_ptr get(array_index record) const;
 
+    /// Return the address of the record at the specified index, valid for
+    /// the scope of the guard.
+    uint8_t* get(const read_guard& memory, array_index record) const;
+
+    /// The file of the records, for construction of a read_guard.
+    const memory_map& file() const;
+
 private:
 
     // The record index of a disk position.
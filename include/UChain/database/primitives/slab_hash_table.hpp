@@ -87,6 +87,12 @@ private:
     // Link a new chain into the bucket header.
     void link(const KeyType& key, const file_offset begin);
 
+    // Visit the position of each row of the chain from current that matches
+    // the key (each row if null) until the visitor returns false. The chain
+    // is read under one remap read lock, without allocation.
+    template <typename Visitor>
+    void walk(file_offset current, const KeyType* key, Visitor visit) const;
+
     // Release node from linked chain.
     template <typename ListItem>
     void release(const ListItem& item, const file_offset previous);
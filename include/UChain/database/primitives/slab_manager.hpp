@@ -26,6 +26,7 @@
 #include <UChain/database/define.hpp>
 #include <UChain/database/memory/memory.hpp>
 #include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/memory/read_guard.hpp>
 
 namespace libbitcoin {
 namespace database {
@@ -59,6 +60,13 @@ public:
     /// Return memory object for the slab at the specified position.
     const memory_ptr get(file_offset position) const;
 
+    /// Return the address of the slab at the specified position, valid for
+    /// the scope of the guard.
+    uint8_t* get(const read_guard& memory, file_offset position) const;
+
+    /// The file of the slabs, for construction of a read_guard.
+    const memory_map& file() const;
+
 //protected:
 
     /// Get the size of all slabs and size prefix (excludes header).
@@ -30,6 +30,9 @@
 namespace libbitcoin {
 namespace database {
 
+/// Set in the stored index of records that carry an output offset table.
+BC_CONSTEXPR uint32_t output_table_flag = 0x80000000;
+
 /// Deferred read transaction result.
 class BCD_API transaction_result
 {
@@ -48,7 +51,21 @@ public:
     /// The transaction.
     chain::transaction transaction() const;
 
+    /// True if the transaction is a coinbase, read without a full decode.
+    bool is_coinbase() const;
+
+    /// The number of outputs in the transaction.
+    size_t output_count() const;
+
+    /// An output where index < output_count, read without a full decode.
+    chain::output output(size_t index) const;
+
+    /// True if the record carries an output offset table.
+    bool has_output_table() const;
+
 private:
+    uint8_t* transaction_data(uint8_t* memory) const;
+
     const memory_ptr slab_;
 };
 
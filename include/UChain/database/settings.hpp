@@ -38,6 +38,9 @@ public:
     /// Properties.
     uint32_t history_start_height;
     uint32_t stealth_start_height;
+
+    /// Address space reserved for each chain table map in GiB, zero to remap.
+    uint32_t map_reservation;
     boost::filesystem::path directory;
     boost::filesystem::path default_directory;
 };
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers 
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_DATABASE_SNAPSHOT_HPP
+#define UC_DATABASE_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <UChain/bitcoin.hpp>
+#include <UChain/database/define.hpp>
+#include <UChain/database/settings.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Offline export and import of the chain state files of a database.
+/// Account (wallet) files are neither exported nor replaced on import.
+/// The database must be closed and not in use by another process.
+class BCD_API snapshot
+{
+public:
+    typedef boost::filesystem::path path;
+
+    /// A chunk of a database file and the sha256 of its content.
+    struct chunk
+    {
+        std::string file;
+        size_t index;
+        uint64_t size;
+        hash_digest checksum;
+    };
+
+    /// The snapshot description, written last and verified first.
+    struct manifest
+    {
+        std::string version;
+        size_t height;
+        std::vector<std::string> files;
+        std::vector<chunk> chunks;
+    };
+
+    static const std::string manifest_name;
+    static const uint64_t chunk_size;
+
+    /// Construct for the database of the given settings.
+    snapshot(const settings& settings, size_t threads);
+
+    /// Write a chunked, checksummed copy of the chain files to directory.
+    bool export_to(const path& directory) const;
+
+    /// Verify the snapshot in directory and replace the chain files with it.
+    bool import_from(const path& directory) const;
+
+private:
+    static bool read_manifest(manifest& out, const path& directory);
+    static bool write_manifest(const manifest& in, const path& directory);
+    static path chunk_path(const path& directory, const chunk& chunk);
+    static bool replace_files(const std::vector<path>& files);
+
+    std::vector<path> chain_files() const;
+    bool is_closed() const;
+    bool read_height(size_t& out_height) const;
+
+    const settings settings_;
+    const size_t threads_;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
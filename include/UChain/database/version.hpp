@@ -12,11 +12,11 @@
  * For interpretation of the versioning scheme see: http://semver.org
  */
 
-#define UC_DATABASE_VERSION "0.0.1"
+#define UC_DATABASE_VERSION "0.0.2"
 
 #define UC_DATABASE_MAJOR_VERSION 0
 #define UC_DATABASE_MINOR_VERSION 0
-#define UC_DATABASE_PATCH_VERSION 1
+#define UC_DATABASE_PATCH_VERSION 2
 
 #define UC_DATABASE_VERSION_NUMBER (((UC_DATABASE_MAJOR_VERSION)*100) + ((UC_DATABASE_MINOR_VERSION)*10) + (UC_DATABASE_PATCH_VERSION))
 
@@ -69,6 +69,19 @@ BCX_API console_result dispatch_command(int argc, const char* argv[],
     Json::Value& jv_output,
     bc::server::server_node& node, uint8_t api_version = 1);
 
+/**
+ * Invoke the named command, binding its options and arguments directly from
+ * JSON-RPC params rather than from a rendered command line.
+ * @param[in]  method  The command symbolic name.
+ * @param[in]  params  The JSON-RPC params array.
+ * @param[in]  node server_node instance.
+ * @param[in]  command version.
+ * @return            The appropriate console return code { -1, 0, 1 }.
+ */
+BCX_API console_result dispatch_command(const std::string& method,
+    const Json::Value& params, Json::Value& jv_output,
+    bc::server::server_node& node, uint8_t api_version);
+
 } // namespace explorer
 } // namespace libbitcoin
 
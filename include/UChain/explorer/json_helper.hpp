@@ -22,6 +22,7 @@
 #define BX_PROPERTY_TREE_HPP
 
 #include <map>
+#include <ostream>
 #include <string>
 #include <vector>
 #include <UChain/bitcoin.hpp>
@@ -492,6 +493,26 @@ BCX_API Json::Value prop_attenuation_model_param(const std::string& param);
 typedef std::tuple<std::string, std::string, Json::Value> account_info;
 BCX_API Json::Value prop_list(const account_info& acc);
 
+/**
+ * Write a value as compact json directly into the stream, without
+ * rendering an intermediate string.
+ * @param[out] output  The stream to write to.
+ * @param[in]  value   The value to write.
+ */
+BCX_API static void write(std::ostream& output, const Json::Value& value);
+
+/**
+ * Write a block as compact json directly into the stream. Transactions are
+ * rendered one at a time, so the whole block tree is never materialized.
+ * The output is identical to writing prop_tree(block, json, tx_json).
+ * @param[out] output   The stream to write to.
+ * @param[in]  block    The block.
+ * @param[in]  json     json output.
+ * @param[in]  tx_json  json output for tx within this block.
+ */
+BCX_API void write(std::ostream& output, const block& block, bool json,
+    bool tx_json);
+
 private:
     uint8_t version_{ 1 }; //1 - api v1; 2 - api v2;
 };
@@ -21,6 +21,7 @@
 #ifndef BX_PARSER_HPP
 #define BX_PARSER_HPP
 
+#include <functional>
 #include <iostream>
 #include <string>
 #include <boost/filesystem.hpp>
@@ -46,6 +47,11 @@ public:
     virtual bool parse(std::string& out_error, std::istream& input,
         int argc, const char* argv[]);
 
+    /// Parse all configuration into member settings, binding the command
+    /// options and arguments directly from JSON-RPC params.
+    virtual bool parse(std::string& out_error, std::istream& input,
+        const Json::Value& params);
+
     virtual bool help() const;
 
     /// Load command line options (named).
@@ -64,7 +70,16 @@ protected:
     virtual void load_command_variables(variables_map& variables,
         std::istream& input, int argc, const char* argv[]);
 
+    /// The first object in params supplies the named options, the remaining
+    /// values are positional arguments, as with a rendered command line.
+    virtual void load_command_variables(variables_map& variables,
+        std::istream& input, const Json::Value& params);
+
 private:
+    typedef std::function<void(variables_map&)> command_loader;
+
+    bool parse(std::string& out_error, command_loader load_command);
+
     static std::string system_config_directory();
     static boost::filesystem::path default_config_path();
 
@@ -28,6 +28,7 @@
 #include <UChain/network/pending_channels.hpp>
 #include <UChain/network/pending_sockets.hpp>
 #include <UChain/network/proxy.hpp>
+#include <UChain/network/rolling_filter.hpp>
 #include <UChain/network/settings.hpp>
 #include <UChain/network/socket.hpp>
 #include <UChain/network/version.hpp>
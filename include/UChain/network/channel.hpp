@@ -29,6 +29,7 @@
 #include <UChain/network/const_buffer.hpp>
 #include <UChain/network/define.hpp>
 #include <UChain/network/proxy.hpp>
+#include <UChain/network/rolling_filter.hpp>
 #include <UChain/network/message_subscriber.hpp>
 #include <UChain/network/settings.hpp>
 #include <UChain/network/socket.hpp>
@@ -58,6 +59,9 @@ public:
 
     void invoke_protocol_start_handler(const code& ec);
 
+    /// Inventory hashes the peer is known to have, shared by its protocols.
+    rolling_filter& known_inventory();
+
 protected:
     virtual void handle_activity();
     virtual void handle_stopping();
@@ -76,6 +80,7 @@ private:
     deadline::ptr expiration_;
     deadline::ptr inactivity_;
     std::function<void()> protocol_start_handler_;
+    rolling_filter known_inventory_;
     upgrade_mutex mutex_;
 };
 
@@ -25,11 +25,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 #include <UChain/bitcoin.hpp>
 #include <UChain/network/channel.hpp>
+#include <UChain/network/const_buffer.hpp>
 #include <UChain/network/define.hpp>
 #include <UChain/bitcoin/message/address.hpp>
 
@@ -63,22 +65,54 @@ public:
     void broadcast(const Message& message, channel_handler handle_channel,
         result_handler handle_complete)
     {
-        // We cannot use a synchronizer here because handler closure in loop.
-        auto counter = std::make_shared<std::atomic<size_t>>(channels_.size());
+        const auto channels = safe_copy();
 
-        for (const auto channel: safe_copy())
+        if (channels.empty())
         {
-            const auto handle_send = [=](code ec)
-            {
-                handle_channel(ec, channel);
+            handle_complete(error::success);
+            return;
+        }
 
-                if (counter->fetch_sub(1) == 1)
-                    handle_complete(error::success);
-            };
+        // We cannot use a synchronizer here because handler closure in loop.
+        auto counter = std::make_shared<std::atomic<size_t>>(channels.size());
 
-            // No pre-serialize, channels may have different protocol versions.
-            channel->send(message, handle_send);
-        }
+        // Channels may differ in protocol version, so the message is
+        // serialized once per distinct encoding and the buffer is shared.
+        std::map<uint64_t, const_buffer> buffers;
+        size_t bytes = 0;
+
+        const auto send_all = [&]()
+        {
+            for (const auto channel: channels)
+            {
+                const auto handle_send = [=](code ec)
+                {
+                    handle_channel(ec, channel);
+
+                    if (counter->fetch_sub(1) == 1)
+                        handle_complete(error::success);
+                };
+
+                const auto encoding = channel->encoding();
+                auto it = buffers.find(encoding);
+
+                if (it == buffers.end())
+                {
+                    it = buffers.emplace(encoding,
+                        channel->serialize(message)).first;
+                    bytes += it->second.size();
+                }
+
+                channel->send(Message::command, it->second, handle_send);
+            }
+        };
+
+        const auto elapsed = timer<asio::microseconds>::duration(send_all);
+
+        log::debug(LOG_NETWORK)
+            << "Broadcast " << Message::command << " to " << channels.size()
+            << " channels with " << buffers.size() << " serializations ("
+            << bytes << " bytes) in " << elapsed.count() << " us";
     }
 
     /// Subscribe to all incoming messages of a type.
@@ -23,69 +23,61 @@
 
 #include <istream>
 #include <functional>
-#include <map>
 #include <memory>
+#include <tuple>
 #include <utility>
-#include <string>
+#include <vector>
 #include <UChain/bitcoin.hpp>
 #include <UChain/network/define.hpp>
 
 namespace libbitcoin {
 namespace network {
 
-#define DEFINE_SUBSCRIBER_TYPE(value) \
-    typedef resubscriber<const code&, message::value::ptr> \
-        value##_subscriber_type
-
-#define DEFINE_SUBSCRIBER_OVERLOAD(value) \
-    template <typename Handler> \
-    void subscribe(message::value&&, Handler&& handler) \
-    { \
-        value##_subscriber_->subscribe(std::forward<Handler>(handler), \
-            error::channel_stopped, nullptr); \
-    }
-
-#define DECLARE_SUBSCRIBER(value) \
-    value##_subscriber_type::ptr value##_subscriber_
-
 template <class Message>
 using message_handler = std::function<bool(const code&,
     std::shared_ptr<Message>)>;
 
-/// Aggregation of subscribers by messasge type, thread safe.
+/// Routing of messages by type to subscribed handlers, thread safe.
+/// Messages are delivered in the context of the loading (read) thread, and
+/// handlers of one subscriber are never invoked concurrently.
 class BCT_API message_subscriber
 {
 public:
-    DEFINE_SUBSCRIBER_TYPE(address);
-    DEFINE_SUBSCRIBER_TYPE(block_message);
-    DEFINE_SUBSCRIBER_TYPE(block_transactions);
-    DEFINE_SUBSCRIBER_TYPE(compact_block);
-    DEFINE_SUBSCRIBER_TYPE(fee_filter);
-    DEFINE_SUBSCRIBER_TYPE(filter_add);
-    DEFINE_SUBSCRIBER_TYPE(filter_clear);
-    DEFINE_SUBSCRIBER_TYPE(filter_load);
-    DEFINE_SUBSCRIBER_TYPE(get_address);
-    DEFINE_SUBSCRIBER_TYPE(get_blocks);
-    DEFINE_SUBSCRIBER_TYPE(get_block_transactions);
-    DEFINE_SUBSCRIBER_TYPE(get_data);
-    DEFINE_SUBSCRIBER_TYPE(get_headers);
-    DEFINE_SUBSCRIBER_TYPE(headers);
-    DEFINE_SUBSCRIBER_TYPE(inventory);
-    DEFINE_SUBSCRIBER_TYPE(memory_pool);
-    DEFINE_SUBSCRIBER_TYPE(merkle_block);
-    DEFINE_SUBSCRIBER_TYPE(not_found);
-    DEFINE_SUBSCRIBER_TYPE(ping);
-    DEFINE_SUBSCRIBER_TYPE(pong);
-    DEFINE_SUBSCRIBER_TYPE(reject);
-    DEFINE_SUBSCRIBER_TYPE(send_headers);
-    DEFINE_SUBSCRIBER_TYPE(send_compact_blocks);
-    DEFINE_SUBSCRIBER_TYPE(transaction_message);
-    DEFINE_SUBSCRIBER_TYPE(verack);
-    DEFINE_SUBSCRIBER_TYPE(version);
+    template <class Message>
+    using handlers = std::vector<message_handler<Message>>;
+
+    /// The routing table, one handler list per message type.
+    typedef std::tuple<
+        handlers<message::address>,
+        handlers<message::block_message>,
+        handlers<message::block_transactions>,
+        handlers<message::compact_block>,
+        handlers<message::fee_filter>,
+        handlers<message::filter_add>,
+        handlers<message::filter_clear>,
+        handlers<message::filter_load>,
+        handlers<message::get_address>,
+        handlers<message::get_blocks>,
+        handlers<message::get_block_transactions>,
+        handlers<message::get_data>,
+        handlers<message::get_headers>,
+        handlers<message::headers>,
+        handlers<message::inventory>,
+        handlers<message::memory_pool>,
+        handlers<message::merkle_block>,
+        handlers<message::not_found>,
+        handlers<message::ping>,
+        handlers<message::pong>,
+        handlers<message::reject>,
+        handlers<message::send_headers>,
+        handlers<message::send_compact_blocks>,
+        handlers<message::transaction_message>,
+        handlers<message::verack>,
+        handlers<message::version>> routing_table;
 
     /**
      * Create an instance of this class.
-     * @param[in]  pool  The threadpool to use for sending notifications.
+     * @param[in]  pool  The threadpool to use for stop notifications.
      */
     message_subscriber(threadpool& pool);
 
@@ -102,47 +94,31 @@ public:
     template <class Message, typename Handler>
     void subscribe(Handler&& handler)
     {
-        subscribe(Message(), std::forward<Handler>(handler));
-    }
+        message_handler<Message> subscription(std::forward<Handler>(handler));
 
-    /**
-     * Load a stream into a message instance and notify subscribers.
-     * @param[in]  stream      The stream from which to load the message.
-     * @param[in]  version  The peer protocol version.
-     * @param[in]  subscriber  The subscriber for the message type.
-     * @return                 Returns error::bad_stream if failed.
-     */
-    template <class Message, class Subscriber>
-    code relay(std::istream& stream, uint32_t version,
-        Subscriber subscriber) const
-    {
-        const auto message_ptr = std::make_shared<Message>();
-        const bool parsed = message_ptr->from_data(version, stream);
-        const code ec(parsed ? error::success : error::bad_stream);
-        subscriber->relay(ec, message_ptr);
-        return ec;
+        if (!router_->subscribe(std::move(subscription)))
+            subscription(error::channel_stopped, nullptr);
     }
 
     /**
      * Load a stream into a message instance and invoke subscribers.
-     * @param[in]  stream      The stream from which to load the message.
+     * @param[in]  stream   The stream from which to load the message.
      * @param[in]  version  The peer protocol version.
-     * @param[in]  subscriber  The subscriber for the message type.
-     * @return                 Returns error::bad_stream if failed.
+     * @return              Returns error::bad_stream if failed.
      */
-    template <class Message, class Subscriber>
-    code handle(std::istream& stream, uint32_t version,
-        Subscriber subscriber) const
+    template <class Message>
+    code handle(std::istream& stream, uint32_t version) const
     {
         const auto message_ptr = std::make_shared<Message>();
         const bool parsed = message_ptr->from_data(version, stream);
         const code ec(parsed ? error::success : error::bad_stream);
-        subscriber->invoke(ec, message_ptr);
+        router_->invoke(ec, message_ptr);
         return ec;
     }
 
     /**
-     * Broadcast a default message instance with the specified error code.
+     * Broadcast a null message instance with the specified error code.
+     * Handlers are invoked on the threadpool, not the calling thread.
      * @param[in]  ec  The error code to broadcast.
      */
     virtual void broadcast(const code& ec);
@@ -170,65 +146,90 @@ public:
     virtual void stop();
 
 private:
-    DEFINE_SUBSCRIBER_OVERLOAD(address);
-    DEFINE_SUBSCRIBER_OVERLOAD(block_message);
-    DEFINE_SUBSCRIBER_OVERLOAD(block_transactions);
-    DEFINE_SUBSCRIBER_OVERLOAD(compact_block);
-    DEFINE_SUBSCRIBER_OVERLOAD(fee_filter);
-    DEFINE_SUBSCRIBER_OVERLOAD(filter_add);
-    DEFINE_SUBSCRIBER_OVERLOAD(filter_clear);
-    DEFINE_SUBSCRIBER_OVERLOAD(filter_load);
-    DEFINE_SUBSCRIBER_OVERLOAD(get_address);
-    DEFINE_SUBSCRIBER_OVERLOAD(get_blocks);
-    DEFINE_SUBSCRIBER_OVERLOAD(get_block_transactions);
-    DEFINE_SUBSCRIBER_OVERLOAD(get_data);
-    DEFINE_SUBSCRIBER_OVERLOAD(get_headers);
-    DEFINE_SUBSCRIBER_OVERLOAD(headers);
-    DEFINE_SUBSCRIBER_OVERLOAD(inventory);
-    DEFINE_SUBSCRIBER_OVERLOAD(memory_pool);
-    DEFINE_SUBSCRIBER_OVERLOAD(merkle_block);
-    DEFINE_SUBSCRIBER_OVERLOAD(not_found);
-    DEFINE_SUBSCRIBER_OVERLOAD(ping);
-    DEFINE_SUBSCRIBER_OVERLOAD(pong);
-    DEFINE_SUBSCRIBER_OVERLOAD(reject);
-    DEFINE_SUBSCRIBER_OVERLOAD(send_headers);
-    DEFINE_SUBSCRIBER_OVERLOAD(send_compact_blocks);
-    DEFINE_SUBSCRIBER_OVERLOAD(transaction_message);
-    DEFINE_SUBSCRIBER_OVERLOAD(verack);
-    DEFINE_SUBSCRIBER_OVERLOAD(version);
-
-    DECLARE_SUBSCRIBER(address);
-    DECLARE_SUBSCRIBER(block_message);
-    DECLARE_SUBSCRIBER(block_transactions);
-    DECLARE_SUBSCRIBER(compact_block);
-    DECLARE_SUBSCRIBER(fee_filter);
-    DECLARE_SUBSCRIBER(filter_add);
-    DECLARE_SUBSCRIBER(filter_clear);
-    DECLARE_SUBSCRIBER(filter_load);
-    DECLARE_SUBSCRIBER(get_address);
-    DECLARE_SUBSCRIBER(get_blocks);
-    DECLARE_SUBSCRIBER(get_block_transactions);
-    DECLARE_SUBSCRIBER(get_data);
-    DECLARE_SUBSCRIBER(get_headers);
-    DECLARE_SUBSCRIBER(headers);
-    DECLARE_SUBSCRIBER(inventory);
-    DECLARE_SUBSCRIBER(memory_pool);
-    DECLARE_SUBSCRIBER(merkle_block);
-    DECLARE_SUBSCRIBER(not_found);
-    DECLARE_SUBSCRIBER(ping);
-    DECLARE_SUBSCRIBER(pong);
-    DECLARE_SUBSCRIBER(reject);
-    DECLARE_SUBSCRIBER(send_headers);
-    DECLARE_SUBSCRIBER(send_compact_blocks);
-    DECLARE_SUBSCRIBER(transaction_message);
-    DECLARE_SUBSCRIBER(verack);
-    DECLARE_SUBSCRIBER(version);
+    // Shared so that a broadcast may outlive the subscriber.
+    class router
+    {
+    public:
+        router();
+
+        void start();
+        void stop();
+        void broadcast(const code& ec);
+
+        template <class Message>
+        bool subscribe(message_handler<Message>&& handler)
+        {
+            // Critical Section
+            ///////////////////////////////////////////////////////////////////
+            unique_lock lock(subscribe_mutex_);
+
+            if (stopped_)
+                return false;
+
+            std::get<handlers<Message>>(table_).emplace_back(
+                std::move(handler));
+            return true;
+            ///////////////////////////////////////////////////////////////////
+        }
+
+        template <class Message>
+        void invoke(const code& ec, std::shared_ptr<Message> message)
+        {
+            // Critical Section (prevent concurrent handler execution)
+            ///////////////////////////////////////////////////////////////////
+            unique_lock lock(invoke_mutex_);
+            do_invoke(ec, message);
+            ///////////////////////////////////////////////////////////////////
+        }
+
+    private:
+        template <size_t... Index>
+        void do_broadcast(const code& ec, std::index_sequence<Index...>);
+
+        template <class Message>
+        void do_broadcast(const code& ec, const handlers<Message>&);
+
+        template <class Message>
+        void do_invoke(const code& ec, std::shared_ptr<Message> message)
+        {
+            auto& table = std::get<handlers<Message>>(table_);
+            handlers<Message> subscriptions;
+
+            // Critical Section (protect stop)
+            ///////////////////////////////////////////////////////////////////
+            subscribe_mutex_.lock();
+            std::swap(subscriptions, table);
+            subscribe_mutex_.unlock();
+            ///////////////////////////////////////////////////////////////////
+
+            // Subscriptions may be created while this loop is executing.
+            // Invoke subscribers from temporary list and resubscribe as
+            // indicated, unless stopped.
+            for (auto& handler: subscriptions)
+            {
+                if (!handler(ec, message))
+                    continue;
+
+                // Critical Section
+                ///////////////////////////////////////////////////////////////
+                unique_lock lock(subscribe_mutex_);
+
+                if (!stopped_)
+                    table.emplace_back(std::move(handler));
+                ///////////////////////////////////////////////////////////////
+            }
+        }
+
+        bool stopped_;
+        routing_table table_;
+        mutable shared_mutex invoke_mutex_;
+        mutable shared_mutex subscribe_mutex_;
+    };
+
+    threadpool& pool_;
+    std::shared_ptr<router> router_;
 };
 
-#undef DEFINE_SUBSCRIBER_TYPE
-#undef DEFINE_SUBSCRIBER_OVERLOAD
-#undef DECLARE_SUBSCRIBER
-
 } // namespace network
 } // namespace libbitcoin
 
@@ -124,6 +124,9 @@ protected:
 
     bool channel_stopped() { return channel_->stopped(); }
 
+    /// Get the inventory hashes the peer is known to have.
+    virtual rolling_filter& known_inventory();
+
 private:
     threadpool& pool_;
     channel::ptr channel_;
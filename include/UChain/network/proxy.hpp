@@ -24,11 +24,13 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 #include <UChain/bitcoin.hpp>
 #include <UChain/network/const_buffer.hpp>
 #include <UChain/network/define.hpp>
@@ -51,11 +53,18 @@ public:
     typedef subscriber<const code&> stop_subscriber;
     typedef resubscriber<const code&, const std::string&, const_buffer,
         result_handler> send_subscriber;
-    using request_callback = std::function<void()>;
+
+    /// Outbound totals, writes per message is the coalescing achieved.
+    struct send_statistics
+    {
+        uint64_t messages;
+        uint64_t writes;
+        uint64_t bytes;
+    };
 
     /// Construct an instance.
     proxy(threadpool& pool, socket::ptr socket, uint32_t protocol_magic,
-        uint32_t protocol_version);
+        uint32_t protocol_version, uint32_t send_flush_bytes, bool no_delay);
 
     /// Validate proxy stopped.
     ~proxy();
@@ -68,9 +77,29 @@ public:
     template <class Message>
     void send(const Message& message, result_handler handler)
     {
-        const auto buffer = const_buffer(message::serialize(protocol_version_,
-            message, protocol_magic_));
-        do_send(message.command, buffer, handler);
+        do_send(message.command, serialize(message), handler);
+    }
+
+    /// Serialize a message as it would be written to this socket.
+    template <class Message>
+    const_buffer serialize(const Message& message) const
+    {
+        return const_buffer(message::serialize(protocol_version_, message,
+            protocol_magic_));
+    }
+
+    /// Send a message already serialized for an equal encoding().
+    void send(const std::string& command, const_buffer buffer,
+        result_handler handler)
+    {
+        do_send(command, buffer, handler);
+    }
+
+    /// Proxies with equal encodings serialize any message identically.
+    uint64_t encoding() const
+    {
+        return (static_cast<uint64_t>(protocol_magic_) << 32) |
+            protocol_version_;
     }
 
     /// Subscribe to messages of the specified type on the socket.
@@ -81,6 +110,9 @@ public:
         message_subscriber_.subscribe<Message>(stopped);
     }
 
+    /// Get the outbound totals of this socket.
+    send_statistics send_stats() const;
+
     /// Subscribe to the stop event.
     virtual void subscribe_stop(result_handler handler);
 
@@ -131,15 +163,26 @@ private:
     void handle_read_payload(const boost_code& ec, size_t,
         const message::heading& head);
 
+    struct pending_send
+    {
+        const_buffer buffer;
+        result_handler handler;
+    };
+
+    typedef std::vector<pending_send> send_batch;
+    typedef std::shared_ptr<send_batch> send_batch_ptr;
+
     void do_send(const std::string& command, const_buffer buffer,
         result_handler handler);
-    void handle_send(const boost_code& ec, const_buffer buffer,
-        result_handler handler);
+    void flush(asio::socket& socket);
+    void handle_send(const boost_code& ec, send_batch_ptr batch);
 
     void handle_request(data_chunk payload_buffer, uint32_t protocol_version_, message::heading head, size_t payload_size);
 
     const uint32_t protocol_magic_;
     const uint32_t protocol_version_;
+    const size_t send_flush_bytes_;
+    const bool no_delay_;
     const config::authority authority_;
 
     // These are protected by sequential ordering.
@@ -155,8 +198,13 @@ private:
     bc::atomic<message::version::ptr> peer_version_message_;
     message_subscriber message_subscriber_;
     stop_subscriber::ptr stop_subscriber_;
-    std::queue<request_callback> outbound_queue_;
-    std::atomic_bool has_sent_;
+    std::atomic<uint64_t> sent_messages_;
+    std::atomic<uint64_t> sent_writes_;
+    std::atomic<uint64_t> sent_bytes_;
+
+    // These are protected by the socket lock.
+    std::deque<pending_send> outbound_queue_;
+    bool sending_;
 
     std::atomic_int misbehaving_;
     static boost::detail::spinlock spinlock_;
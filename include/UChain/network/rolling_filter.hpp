@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers 
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_NETWORK_ROLLING_FILTER_HPP
+#define UC_NETWORK_ROLLING_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <UChain/bitcoin.hpp>
+#include <UChain/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// A bloom filter of recently seen hashes in two generations, thread safe.
+/// When the current generation fills it replaces the previous one, so at
+/// least the most recent capacity hashes are always remembered.
+class BCT_API rolling_filter
+{
+public:
+    /// Construct a filter of capacity hashes per generation.
+    rolling_filter(size_t capacity, double false_positive_rate);
+
+    /// This class is not copyable.
+    rolling_filter(const rolling_filter&) = delete;
+    void operator=(const rolling_filter&) = delete;
+
+    /// Add a hash to the current generation.
+    void insert(const hash_digest& hash);
+
+    /// True if the hash may have been inserted (false positives possible).
+    bool contains(const hash_digest& hash) const;
+
+    /// Forget all hashes.
+    void clear();
+
+private:
+    typedef std::vector<uint64_t> generation;
+
+    bool test(const generation& bits, uint64_t first, uint64_t step) const;
+    void seed(const hash_digest& hash, uint64_t& first, uint64_t& step) const;
+
+    const size_t capacity_;
+    const size_t bits_;
+    const size_t hashes_;
+    const uint64_t salt_;
+
+    // These are protected by mutex.
+    size_t count_;
+    generation current_;
+    generation previous_;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
@@ -51,6 +51,8 @@ public:
     uint32_t channel_inactivity_minutes;
     uint32_t channel_expiration_minutes;
     uint32_t channel_germination_seconds;
+    uint32_t channel_send_flush_bytes;
+    bool channel_no_delay;
     uint32_t host_pool_capacity;
     bool relay_transactions;
     bool enable_re_seeding;
@@ -38,5 +38,6 @@
 #include <UChain/node/utility/performance.hpp>
 #include <UChain/node/utility/reservation.hpp>
 #include <UChain/node/utility/reservations.hpp>
+#include <UChain/node/utility/transaction_requests.hpp>
 
 #endif
@@ -30,6 +30,7 @@
 #include <UChain/node/sessions/session_block_sync.hpp>
 #include <UChain/node/sessions/session_header_sync.hpp>
 #include <UChain/node/utility/header_queue.hpp>
+#include <UChain/node/utility/transaction_requests.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -122,6 +123,7 @@ private:
     // These are thread safe.
     header_queue hashes_;
     const settings& settings_;
+    transaction_requests requests_;
 protected:
     // fix me, for explorer only.
     blockchain::block_chain_impl blockchain_;
@@ -23,6 +23,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <deque>
 #include <memory>
 #include <UChain/blockchain.hpp>
 #include <UChain/network.hpp>
@@ -60,10 +61,11 @@ private:
     typedef message::block_message::ptr_list block_ptr_list;
     typedef chain::header::list header_list;
 
+    void send_next_data(get_data_ptr message, size_t index);
     void send_block(const code& ec, chain::block::ptr block,
-        const hash_digest& hash);
-    void send_merkle_block(const code& ec, merkle_block_ptr message,
-        const hash_digest& hash);
+        get_data_ptr message, size_t index);
+    void send_merkle_block(const code& ec, merkle_block_ptr merkle,
+        get_data_ptr message, size_t index);
 
     bool handle_receive_get_data(const code& ec, get_data_ptr message);
     bool handle_receive_get_blocks(const code& ec, get_blocks_ptr message);
@@ -84,6 +86,11 @@ private:
     bc::atomic<hash_digest> last_locator_top_;
     std::atomic<size_t> current_chain_height_;
     std::atomic<bool> headers_to_peer_;
+
+    // Protected by mutex, get_data requests are answered one at a time and
+    // the request being answered is at the front.
+    std::deque<get_data_ptr> get_data_queue_;
+    unique_mutex get_data_mutex_;
 };
 
 } // namespace node
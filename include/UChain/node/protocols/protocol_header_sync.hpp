@@ -21,6 +21,7 @@
 #ifndef UC_NODE_PROTOCOL_HEADER_SYNC_HPP
 #define UC_NODE_PROTOCOL_HEADER_SYNC_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -29,6 +30,7 @@
 #include <UChain/node/configuration.hpp>
 #include <UChain/node/define.hpp>
 #include <UChain/node/utility/header_queue.hpp>
+#include <UChain/node/utility/performance.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -42,8 +44,7 @@ public:
 
     /// Construct a header sync protocol instance.
     protocol_header_sync(network::p2p& network, network::channel::ptr channel,
-        header_queue& hashes, uint32_t minimum_rate,
-        const config::checkpoint& last);
+        header_queue& hashes, uint32_t minimum_rate);
 
     /// Start the protocol.
     virtual void start(event_handler handler);
@@ -51,11 +52,8 @@ public:
 private:
     typedef message::headers::ptr headers_ptr;
 
-    static size_t final_height(header_queue& headers,
-        const config::checkpoint::list& checkpoints);
-
-    size_t sync_rate() const;
-    size_t next_height() const;
+    bool claim_range();
+    performance sync_rate() const;
 
     void send_get_headers(event_handler complete);
     void handle_send(const code& ec, event_handler complete);
@@ -64,15 +62,17 @@ private:
     bool handle_receive(const code& ec, headers_ptr message,
         event_handler complete);
 
-    // Thread safe and guarded by sequential header sync.
+    // Thread safe, shared by all header sync channels.
     header_queue& hashes_;
 
     // This is guarded by protocol_timer/deadline contract (exactly one call).
     size_t current_second_;
 
+    // The range claimed by this channel and the headers it has merged.
+    std::atomic<size_t> range_;
+    std::atomic<size_t> received_;
+
     const uint32_t minimum_rate_;
-    const size_t start_size_;
-    const config::checkpoint last_;
 };
 
 } // namespace node
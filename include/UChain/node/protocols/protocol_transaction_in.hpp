@@ -25,6 +25,7 @@
 #include <UChain/blockchain.hpp>
 #include <UChain/network.hpp>
 #include <UChain/node/define.hpp>
+#include <UChain/node/utility/transaction_requests.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -38,7 +39,7 @@ public:
     /// Construct a transaction protocol instance.
     protocol_transaction_in(network::p2p& network,
         network::channel::ptr channel, blockchain::block_chain& blockchain,
-        blockchain::transaction_pool& pool);
+        blockchain::transaction_pool& pool, transaction_requests& requests);
 
     ptr do_subscribe();
 
@@ -53,6 +54,7 @@ private:
     typedef message::block_message::ptr_list block_ptr_list;
     typedef message::block_message::ptr block_ptr;
 
+    bool request_transaction(const hash_digest& hash);
     void send_get_data(const code& ec, get_data_ptr message);
     void handle_filter_floaters(const code& ec, get_data_ptr message);
     bool handle_receive_inventory(const code& ec, inventory_ptr message);
@@ -67,6 +69,7 @@ private:
 
     blockchain::block_chain& blockchain_;
     blockchain::transaction_pool& pool_;
+    transaction_requests& requests_;
     const bool relay_from_peer_;
     const bool peer_suports_memory_pool_;
     const bool refresh_pool_;
@@ -57,6 +57,11 @@ private:
 
     void send_transaction(const code& ec,
         const chain::transaction& transaction, const hash_digest& hash);
+    void send_transactions(const code& ec,
+        const chain::transaction::list& transactions,
+        const hash_list& missing);
+    void handle_pool_misses(const code& ec,
+        std::shared_ptr<hash_list> misses);
 
     bool handle_receive_get_data(const code& ec, get_data_ptr message);
     bool handle_receive_fee_filter(const code& ec, fee_filter_ptr message);
@@ -43,7 +43,7 @@ public:
     typedef std::shared_ptr<session_block_sync> ptr;
 
     session_block_sync(network::p2p& network, header_queue& hashes,
-        blockchain::simple_chain& chain, const settings& settings);
+        blockchain::block_chain_impl& chain, const settings& settings);
 
     virtual void start(result_handler handler);
 
@@ -75,7 +75,7 @@ private:
     void handle_timer(const code& ec, network::connector::ptr connect);
 
     // These are thread safe.
-    blockchain::simple_chain& blockchain_;
+    blockchain::block_chain_impl& blockchain_;
     reservations reservations_;
     deadline::ptr timer_;
     unique_mutex mutex_;
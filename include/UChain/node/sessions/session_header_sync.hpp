@@ -21,6 +21,7 @@
 #ifndef UC_NODE_SESSION_HEADER_SYNC_HPP
 #define UC_NODE_SESSION_HEADER_SYNC_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -33,7 +34,7 @@
 namespace libbitcoin {
 namespace node {
 
-/// Class to manage initial header download connection, thread safe.
+/// Class to manage initial header download connections, thread safe.
 class BCN_API session_header_sync
   : public network::session_batch, track<session_header_sync>
 {
@@ -69,13 +70,19 @@ private:
     void handle_channel_start(const code& ec, network::connector::ptr connect,
         network::channel::ptr channel, result_handler handler);
     void handle_channel_stop(const code& ec, network::connector::ptr connect, result_handler handler);
-    code get_range(config::checkpoint& out_seed, config::checkpoint& out_stop);
+    void retry(network::connector::ptr connect, result_handler handler);
+    void finish(const code& ec, result_handler handler);
+    bool is_open() const;
+    code get_range(config::checkpoint& out_seed, config::checkpoint& out_stop,
+        chain::header& out_parent);
 
     // Thread safe.
     header_queue& hashes_;
 
-    // These do not require guard because they are not used concurrently.
-    uint32_t minimum_rate_;
+    // Channels complete concurrently, so the rate is shared atomically.
+    std::atomic<uint32_t> minimum_rate_;
+
+    // This does not require guard because it is set before any channel.
     config::checkpoint last_;
     blockchain::simple_chain& blockchain_;
     const config::checkpoint::list checkpoints_;
@@ -25,6 +25,7 @@
 #include <UChain/blockchain.hpp>
 #include <UChain/network.hpp>
 #include <UChain/node/define.hpp>
+#include <UChain/node/utility/transaction_requests.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -38,7 +39,7 @@ public:
 
     /// Construct an instance.
     session_manual(network::p2p& network, blockchain::block_chain& blockchain,
-        blockchain::transaction_pool& pool);
+        blockchain::transaction_pool& pool, transaction_requests& requests);
 
 protected:
     void attach_handshake_protocols(network::channel::ptr channel, result_handler handle_started);
@@ -47,6 +48,7 @@ protected:
 
     blockchain::block_chain& blockchain_;
     blockchain::transaction_pool& pool_;
+    transaction_requests& requests_;
 };
 
 } // namespace node
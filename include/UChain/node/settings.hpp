@@ -38,6 +38,7 @@ public:
     /// Properties.
     uint32_t block_timeout_seconds;
     uint32_t download_connections;
+    uint32_t transaction_timeout_seconds;
     bool transaction_pool_refresh;
 };
 
@@ -72,7 +72,61 @@ public:
     /// Mark the heights if they exist.
     void invalidate(size_t first_height, size_t count);
 
+    /// Split the span from the last element to stop at each checkpoint.
+    /// A null stop hash leaves the final range open to the peer's best header.
+    /// The parent is the header of the last element, used to verify work.
+    void partition(const config::checkpoint& stop,
+        const chain::header& parent);
+
+    /// Claim an unassigned range for download, false if none remain.
+    bool claim(size_t& out_range);
+
+    /// Return an incomplete claimed range for reassignment.
+    void release(size_t range);
+
+    /// The last hash obtained for the range and the range stop.
+    bool locate(size_t range, hash_digest& out_last,
+        config::checkpoint& out_stop) const;
+
+    /// Merge the hashes in the message with those in the range.
+    bool enqueue(size_t range, message::headers::ptr message);
+
+    /// True if the range has been filled to its stop checkpoint.
+    bool complete(size_t range) const;
+
+    /// Complete an open range at the last header obtained, if that header is
+    /// at or above the given height, false if bounded or short of the height.
+    bool seal(size_t range, size_t height);
+
+    /// The height of the last checkpoint, above which headers are verified.
+    size_t trusted_height() const;
+
+    /// True if every range has been merged into the queue.
+    bool synchronized() const;
+
+    /// The number of ranges neither claimed nor complete.
+    size_t unclaimed() const;
+
+    /// The number of ranges and the number merged into the queue.
+    size_t ranges() const;
+    size_t merged() const;
+
 private:
+    // A checkpoint bounded span of headers, starting at a known hash.
+    // The base is the header of the start hash and the parent is the last
+    // header merged, when known, for work validation.
+    struct range
+    {
+        size_t height;
+        hash_list hashes;
+        config::checkpoint stop;
+        chain::header base;
+        chain::header parent;
+        bool open;
+        bool claimed;
+        bool complete;
+    };
+
     // True if the queue is empty (not locked).
     bool is_empty() const;
 
@@ -88,9 +142,18 @@ private:
     // Merge a list of block hashes to the list, validating linkage.
     bool merge(const chain::header::list& headers);
 
+    // Merge a list of block hashes to the range, validating linkage.
+    bool merge(range& span, const chain::header::list& headers);
+
+    // Append completed ranges to the list in height order.
+    void merge_ranges();
+
     // Determine if the hash violates a checkpoint.
     bool check(const hash_digest& hash, size_t height) const;
 
+    // Determine if the header carries valid work relative to its parent.
+    bool verify(const chain::header& header, const range& span) const;
+
     // Determine if the hash is linked to the give (preceding) header.
     bool linked(const chain::header& header, const hash_digest& hash) const;
 
@@ -101,6 +164,8 @@ private:
     size_t height_;
     hash_list list_;
     hash_list::iterator head_;
+    std::vector<range> ranges_;
+    size_t merged_;
     mutable upgrade_mutex mutex_;
 };
 
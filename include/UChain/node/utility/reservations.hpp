@@ -23,6 +23,7 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <vector>
 #include <UChain/blockchain.hpp>
@@ -49,8 +50,8 @@ public:
 
     /// Construct a reservation table of reservations, allocating hashes evenly
     /// among the rows up to the limit of a single get headers p2p request.
-    reservations(header_queue& hashes, blockchain::simple_chain& chain,
-        const settings& settings);
+    reservations(threadpool& pool, header_queue& hashes,
+        blockchain::block_chain_impl& chain, const settings& settings);
 
     /// The average and standard deviation of block import rates.
     rate_statistics rates() const;
@@ -59,7 +60,8 @@ public:
     reservation::list table() const;
 
     /// Import the given block to the blockchain at the specified height.
-    bool import(chain::block::ptr block, size_t height);
+    /// Blocks above the last checkpoint are organized in height order.
+    bool import(message::block_message::ptr block, size_t height);
 
     /// Populate a starved row by taking half of the hashes from a weak row.
     bool populate(reservation::ptr minimal);
@@ -95,9 +97,42 @@ private:
     // Move the maximum unreserved hashes to the specified reservation.
     bool reserve(reservation::ptr minimal);
 
+    // The request limit for a row starting at the given height.
+    size_t max_request(size_t height) const;
+
+    // Blocks awaiting their parents by height. These are shared with the
+    // organizing pass, which may still be queued when this object is gone.
+    struct pending_blocks
+    {
+        size_t contiguous;
+        std::map<size_t, message::block_message::ptr> blocks;
+        bool organizing;
+        unique_mutex mutex;
+    };
+
+    typedef std::shared_ptr<pending_blocks> pending_ptr;
+
+    // Start organizing buffered blocks unless a pass is already queued.
+    void schedule();
+
+    // Submit buffered blocks that extend the chain to the organizer.
+    static void organize(pending_ptr pending,
+        blockchain::block_chain_impl& chain);
+
+    // Take the buffered block at the first gap, if any (not locked).
+    static bool next_pending(pending_blocks& pending,
+        blockchain::block_chain_impl& chain,
+        message::block_message::ptr& out_block, size_t& out_height);
+
     // Thread safe.
     header_queue& hashes_;
-    blockchain::simple_chain& blockchain_;
+    blockchain::block_chain_impl& blockchain_;
+
+    // Organizing runs on the pool, off the network threads.
+    dispatcher dispatch_;
+
+    // Protected by its own mutex.
+    pending_ptr pending_;
 
     // Protected by mutex.
     reservation::list table_;
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers 
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UC_NODE_TRANSACTION_REQUESTS_HPP
+#define UC_NODE_TRANSACTION_REQUESTS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <UChain/bitcoin.hpp>
+#include <UChain/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Node-wide table of transactions requested from peers, thread safe.
+/// Each transaction is requested from one announcing peer at a time, other
+/// announcers are kept as fallbacks in case that request times out.
+class BCN_API transaction_requests
+{
+public:
+    /// Request the hash from a fallback peer, false if the peer is gone.
+    typedef std::function<bool(const hash_digest&)> request_handler;
+
+    /// Construct a table with the given per-request timeout.
+    transaction_requests(const asio::duration& timeout);
+
+    /// This class is not copyable.
+    transaction_requests(const transaction_requests&) = delete;
+    void operator=(const transaction_requests&) = delete;
+
+    /// True if the peer should request the hash now, otherwise the peer
+    /// is recorded as a fallback for the request already in flight.
+    bool claim(const hash_digest& hash, uint64_t peer,
+        request_handler fallback);
+
+    /// The transaction has arrived (from any peer), stop tracking it.
+    void complete(const hash_digest& hash);
+
+    /// The peer is gone, its requests pass to their fallbacks now.
+    void release(uint64_t peer);
+
+    /// The number of transactions in flight.
+    size_t size() const;
+
+    /// The number of get_data requests issued and avoided.
+    uint64_t requested() const;
+    uint64_t suppressed() const;
+
+    /// The number of requests passed to a fallback peer.
+    uint64_t reassigned() const;
+
+private:
+    typedef std::pair<uint64_t, request_handler> fallback;
+
+    struct entry
+    {
+        uint64_t owner;
+        asio::time_point deadline;
+        std::vector<fallback> fallbacks;
+    };
+
+    typedef std::pair<asio::time_point, hash_digest> expiry;
+    typedef std::vector<std::pair<hash_digest, fallback>> request_list;
+
+    void expire();
+    request_list collect_expired(const asio::time_point& now);
+
+    const asio::duration timeout_;
+    std::atomic<uint64_t> requested_;
+    std::atomic<uint64_t> suppressed_;
+    std::atomic<uint64_t> reassigned_;
+
+    // These are protected by mutex.
+    std::unordered_map<hash_digest, entry> entries_;
+    std::deque<expiry> expiries_;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
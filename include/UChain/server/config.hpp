@@ -52,6 +52,10 @@ public:
     configuration(bc::settings context);
     configuration(const configuration& other);
 
+    /// Options.
+    boost::filesystem::path export_snapshot;
+    boost::filesystem::path import_snapshot;
+
     /// Settings.
     server::settings server;
 };
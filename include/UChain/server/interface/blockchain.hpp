@@ -22,6 +22,7 @@
 #define UC_SERVER_BLOCKCHAIN_HPP
 
 #include <cstddef>
+#include <vector>
 #include <UChain/blockchain.hpp>
 #include <UChain/server/define.hpp>
 #include <UChain/server/messages/message.hpp>
@@ -44,6 +45,14 @@ public:
     static void fetch_transaction(server_node& node,
         const message& request, send_handler handler);
 
+    /// Fetch the blockchain histories of many payment addresses.
+    static void fetch_histories(server_node& node,
+        const message& request, send_handler handler);
+
+    /// Fetch many transactions from the blockchain by their hashes.
+    static void fetch_transactions(server_node& node,
+        const message& request, send_handler handler);
+
     /// Fetch the current height of the blockchain.
     static void fetch_last_height(server_node& node,
         const message& request, send_handler handler);
@@ -76,7 +85,28 @@ public:
     static void fetch_stealth2(server_node& node,
         const message& request, send_handler handler);
 
+    /// The maximum number of keys in one batched request.
+    static const size_t maximum_batch;
+
 private:
+    static void history_fetched(const code& ec,
+        const std::vector<chain::history_compact::list>& histories,
+        const message& request, send_handler handler);
+
+    static void histories_fetched(const code& ec,
+        const std::vector<chain::history_compact::list>& histories,
+        const message& request, send_handler handler);
+
+    static void transaction_fetched(const code& ec,
+        const chain::transaction::list& transactions,
+        const hash_list& missing, const message& request,
+        send_handler handler);
+
+    static void transactions_fetched(const code& ec,
+        const chain::transaction::list& transactions,
+        const hash_list& missing, const message& request,
+        send_handler handler);
+
     static void last_height_fetched(const code& ec, size_t last_height,
         const message& request, send_handler handler);
 
@@ -35,12 +35,14 @@ class BCS_API address_key
 public:
     address_key(const route& reply_to, const binary& prefix_filter);
     bool operator==(const address_key& other) const;
+    bool operator<(const address_key& other) const;
     const route& reply_to() const;
     const binary& prefix_filter() const;
 
 private:
-    const route& reply_to_;
-    const binary& prefix_filter_;
+    // Keys are stored by subscriptions, so they must own their values.
+    route reply_to_;
+    binary prefix_filter_;
 };
 
 } // namespace server
@@ -23,6 +23,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 #include <UChain/bitcoin.hpp>
 #include <UChain/server/define.hpp>
 #include <UChain/server/messages/message.hpp>
@@ -84,6 +85,7 @@ private:
         const hash_digest&, const chain::transaction&> address_subscriber;
     typedef notifier<address_key, const code&, uint32_t,
         const hash_digest&, const hash_digest&> penetration_subscriber;
+    typedef subscription_index<address_key> address_index;
 
     // Remove expired subscriptions.
     void purge();
@@ -115,6 +117,12 @@ private:
     void notify_penetration(uint32_t height, const hash_digest& block_hash,
         const hash_digest& tx_hash);
 
+    // Collect the keys of the index with a filter matching the field.
+    bool find_keys(const address_index& index, const binary& field,
+        std::vector<address_key>& out) const;
+    void index_key(address_index& index, const address_key& key);
+    void unindex_key(address_index& index, const address_key& key);
+
     // Send a notification to the subscriber.
     void send(const route& reply_to, const std::string& command,
         uint32_t id, const data_chunk& payload);
@@ -150,6 +158,14 @@ private:
     payment_subscriber::ptr payment_subscriber_;
     stealth_subscriber::ptr stealth_subscriber_;
     penetration_subscriber::ptr penetration_subscriber_;
+
+    // These are protected by mutex.
+    // Subscriptions by prefix filter, so that a notification is only relayed
+    // to the subscribers with a matching filter.
+    address_index payment_index_;
+    address_index stealth_index_;
+    address_index address_index_;
+    mutable shared_mutex index_mutex_;
 };
 
 } // namespace server
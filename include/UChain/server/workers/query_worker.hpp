@@ -20,6 +20,8 @@
 #ifndef UC_SERVER_QUERY_WORKER_HPP
 #define UC_SERVER_QUERY_WORKER_HPP
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <string>
@@ -58,11 +60,23 @@ protected:
     virtual bool connect(socket& router);
     virtual bool disconnect(socket& router);
     virtual void query(socket& router);
+    virtual void respond(socket& router);
 
     // Implement the worker.
     virtual void work();
 
 private:
+    // Responses may complete on other threads, but the socket may only be
+    // used by the worker thread, so they are queued here for it to send.
+    struct response_queue
+    {
+        std::atomic<size_t> outstanding;
+        std::deque<message> responses;
+        shared_mutex mutex;
+    };
+
+    typedef std::shared_ptr<response_queue> response_queue_ptr;
+
     const bool secure_;
     const server::settings& settings_;
 
@@ -72,6 +86,9 @@ private:
 
     // This is protected by base class mutex.
     command_map command_handlers_;
+
+    // This is thread safe.
+    const response_queue_ptr responses_;
 };
 
 } // namespace server
@@ -21,6 +21,7 @@
 #include <atomic>
 #include <string>
 #include <memory>
+#include <vector>
 #include <mongoose/mongoose.h>
 
 namespace mgbubble {
@@ -104,6 +105,8 @@ protected:
     bool send(struct mg_connection& nc, const char* msg, size_t len, bool close_required = false);
     bool send_frame(struct mg_connection& nc, const std::string& msg, bool binary = false);
     bool send_frame(struct mg_connection& nc, const char* msg, size_t len, bool binary = false);
+    // compose one frame from several buffers, none of which is copied first.
+    bool send_frame(struct mg_connection& nc, const std::vector<mg_str>& parts, bool binary = false);
 
     void serve_http_static(struct mg_connection& nc, struct http_message& hm)
     {
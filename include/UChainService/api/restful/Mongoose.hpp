@@ -92,9 +92,16 @@ public:
 
     void data_to_arg(uint8_t rpc_version) override;
 
+    // parse and validate the JSON-RPC body, without rendering it to argv.
+    const Json::Value& data_to_json(uint8_t rpc_version);
+
+    auto json_method() const { return root_["method"].asString(); }
+    const Json::Value& json_params() const { return root_["params"]; }
+
 private:
     int64_t jsonrpc_id_;
     http_message* impl_;
+    Json::Value root_;
 };
 
 class WebsocketMessage:public ToCommandArg { // connect to bx command-tool
@@ -71,7 +71,7 @@ class WsPushServ : public MgServer {
 
 public:
     explicit WsPushServ(libbitcoin::server::server_node& node, const std::string& srv_addr)
-        : node_(node), MgServer(srv_addr)
+        : node_(node), MgServer(srv_addr), subscriber_index_(address_key_bits)
     {}
 
     ~WsPushServ() noexcept { stop(); };
@@ -120,16 +120,28 @@ private:
     typedef std::vector<std::string> string_vector;
     typedef std::map<std::weak_ptr<mg_connection>, string_vector,
             std::owner_less<std::weak_ptr<mg_connection>>> connection_string_map;
+    typedef bc::subscription_index<std::weak_ptr<mg_connection>,
+            std::owner_less<std::weak_ptr<mg_connection>>> connection_index;
+
+    // Subscriptions are indexed by address version and hash.
+    static constexpr size_t address_key_bits = (1 + bc::short_hash_size) * bc::byte_bits;
+    static bc::binary to_address_key(const bc::wallet::payment_address& address);
+
+    void do_notify(
+        const std::vector<std::weak_ptr<mg_connection>>& notify_cons,
+        const Json::Value& value,
+        std::shared_ptr<connection_string_map> topic_map = nullptr);
 
     void do_notify(
         const std::vector<std::weak_ptr<mg_connection>>& notify_cons,
-        Json::Value& value,
+        std::shared_ptr<const std::string> frame,
         std::shared_ptr<connection_string_map> topic_map = nullptr);
 
 private:
     libbitcoin::server::server_node& node_;
     std::unordered_map<void*, std::shared_ptr<mg_connection>> map_connections_;
     connection_string_map subscribers_;
+    connection_index subscriber_index_;
     std::mutex subscribers_lock_;
 
     connection_string_map block_subscribers_;
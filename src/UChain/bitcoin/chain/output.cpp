@@ -139,6 +139,13 @@ std::string output::get_script_address() const
     return payment_address.encoded();
 }
 
+// Compares in binary, so is preferred to get_script_address in loops.
+bool output::is_script_address(const wallet::payment_address& address) const
+{
+    const auto payment_address = wallet::payment_address::extract(script);
+    return payment_address && payment_address == address;
+}
+
 code output::check_asset_address(bc::blockchain::block_chain_impl& chain) const
 {
     bool is_token = false;
@@ -20,6 +20,9 @@
  */
 #include <UChain/bitcoin/formats/base_58.hpp>
 
+#include <algorithm>
+#include <array>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 #include <UChain/bitcoin/utility/assert.hpp>
 
@@ -44,15 +47,30 @@ bool is_base58(const std::string& text)
     return std::all_of(text.begin(), text.end(), test);
 }
 
-template <typename Data>
-auto search_first_nonzero(const Data& data) -> decltype(data.cbegin())
+// Encoding accumulates in little-endian limbs of 58^5, consuming up to four
+// bytes per pass, and decoding in limbs of 2^32, consuming up to five digits
+// per pass. Both intermediate products fit in 64 bits, and this replaces a
+// division per digit per input byte with one per limb per input word.
+static const uint32_t base58_limb = 656356768; // 58^5
+static const size_t base58_limb_digits = 5;
+static const size_t base256_limb_bytes = 4;
+
+static const uint32_t base58_powers[] =
 {
-    auto first_nonzero = data.cbegin();
-    while (first_nonzero != data.end() && *first_nonzero == 0)
-        ++first_nonzero;
+    1, 58, 3364, 195112, 11316496, 656356768
+};
 
-    return first_nonzero;
-}
+static const std::array<int8_t, 256> base58_values = []()
+{
+    std::array<int8_t, 256> values;
+    values.fill(-1);
+
+    for (size_t index = 0; index < base58_chars.size(); ++index)
+        values[static_cast<uint8_t>(base58_chars[index])] =
+            static_cast<int8_t>(index);
+
+    return values;
+}();
 
 size_t count_leading_zeros(data_slice unencoded)
 {
@@ -69,52 +87,62 @@ size_t count_leading_zeros(data_slice unencoded)
     return leading_zeros;
 }
 
-void pack_value(data_chunk& indexes, size_t carry)
+static void multiply_add(std::vector<uint32_t>& limbs, uint64_t multiplier,
+    uint64_t carry, uint64_t base)
 {
-    // Apply "b58 = b58 * 256 + ch".
-    for (auto it = indexes.rbegin(); it != indexes.rend(); ++it)
+    for (auto& limb: limbs)
     {
-        carry += 256 * (*it);
-        *it = carry % 58;
-        carry /= 58;
+        carry += limb * multiplier;
+        limb = static_cast<uint32_t>(carry % base);
+        carry /= base;
     }
 
-    BITCOIN_ASSERT(carry == 0);
+    for (; carry != 0; carry /= base)
+        limbs.push_back(static_cast<uint32_t>(carry % base));
 }
 
 std::string encode_base58(data_slice unencoded)
 {
-    size_t leading_zeros = count_leading_zeros(unencoded);
+    const size_t leading_zeros = count_leading_zeros(unencoded);
 
-    // size = log(256) / log(58), rounded up.
+    // size = log(256) / log(58), rounded up, in limbs of five digits.
     const size_t number_nonzero = unencoded.size() - leading_zeros;
-    const size_t indexes_size = number_nonzero * 138 / 100 + 1;
-
-    // Allocate enough space in big-endian base58 representation.
-    data_chunk indexes(indexes_size);
+    std::vector<uint32_t> limbs;
+    limbs.reserve((number_nonzero * 138 / 100 + 1) / base58_limb_digits + 1);
 
-    // Process the bytes.
-    for (auto it = unencoded.begin() + leading_zeros;
-        it != unencoded.end(); ++it)
+    // Process the bytes, big-endian, up to a 32 bit word at a time.
+    auto it = unencoded.begin() + leading_zeros;
+    while (it != unencoded.end())
     {
-        pack_value(indexes, *it);
-    }
+        const auto remaining = static_cast<size_t>(unencoded.end() - it);
+        const auto bytes = std::min(remaining, base256_limb_bytes);
+
+        uint64_t word = 0;
+        for (size_t byte = 0; byte < bytes; ++byte)
+            word = (word << 8) | *it++;
 
-    // Skip leading zeroes in base58 result.
-    auto first_nonzero = search_first_nonzero(indexes);
+        multiply_add(limbs, uint64_t(1) << (8 * bytes), word, base58_limb);
+    }
 
-    // Translate the result into a string.
+    // Translate the limbs into digits, most significant first.
     std::string encoded;
-    const size_t estimated_size = leading_zeros +
-        (indexes.end() - first_nonzero);
-    encoded.reserve(estimated_size);
-    encoded.assign(leading_zeros, '1');
+    encoded.reserve(leading_zeros + limbs.size() * base58_limb_digits);
+    encoded.assign(leading_zeros, base58_chars[0]);
 
-    // Set actual main bytes.
-    for (auto it = first_nonzero; it != indexes.end(); ++it)
+    bool started = false;
+    for (auto limb = limbs.rbegin(); limb != limbs.rend(); ++limb)
     {
-        const size_t index = *it;
-        encoded += base58_chars[index];
+        for (auto digit = base58_limb_digits; digit > 0; --digit)
+        {
+            const auto index = (*limb / base58_powers[digit - 1]) % 58;
+
+            // Skip leading zeroes in base58 result.
+            if (index == 0 && !started)
+                continue;
+
+            started = true;
+            encoded += base58_chars[index];
+        }
     }
 
     return encoded;
@@ -135,48 +163,53 @@ size_t count_leading_zeros(const std::string& encoded)
     return leading_zeros;
 }
 
-void unpack_char(data_chunk& data, size_t carry)
-{
-    for (auto it = data.rbegin(); it != data.rend(); it++)
-    {
-        carry += 58 * (*it);
-        *it = carry % 256;
-        carry /= 256;
-    }
-
-    BITCOIN_ASSERT(carry == 0);
-}
-
 bool decode_base58(data_chunk& out, const std::string& in)
 {
-    // Trim spaces and newlines around the string.
     const auto leading_zeros = count_leading_zeros(in);
 
-    // log(58) / log(256), rounded up.
-    const size_t data_size = in.size() * 733 / 1000 + 1;
-
-    // Allocate enough space in big-endian base256 representation.
-    data_chunk data(data_size);
+    // log(58) / log(256), rounded up, in limbs of four bytes.
+    std::vector<uint32_t> limbs;
+    limbs.reserve((in.size() * 733 / 1000 + 1) / base256_limb_bytes + 1);
 
-    // Process the characters.
-    for (auto it = in.begin() + leading_zeros; it != in.end(); ++it)
+    // Process the characters, up to five digits at a time.
+    auto it = in.begin() + leading_zeros;
+    while (it != in.end())
     {
-        const auto carry = base58_chars.find(*it);
-        if (carry == std::string::npos)
-            return false;
+        const auto remaining = static_cast<size_t>(in.end() - it);
+        const auto digits = std::min(remaining, base58_limb_digits);
 
-        unpack_char(data, carry);
-    }
+        uint64_t word = 0;
+        for (size_t digit = 0; digit < digits; ++digit)
+        {
+            const auto value = base58_values[static_cast<uint8_t>(*it++)];
+            if (value < 0)
+                return false;
+
+            word = word * 58 + value;
+        }
 
-    // Skip leading zeroes in data.
-    auto first_nonzero = search_first_nonzero(data);
+        multiply_add(limbs, base58_powers[digits], word,
+            uint64_t(1) << 32);
+    }
 
-    // Copy result into output vector.
+    // Copy result into output vector, skipping leading zeroes in data.
     data_chunk decoded;
-    const size_t estimated_size = leading_zeros + (data.end() - first_nonzero);
-    decoded.reserve(estimated_size);
+    decoded.reserve(leading_zeros + limbs.size() * base256_limb_bytes);
     decoded.assign(leading_zeros, 0x00);
-    decoded.insert(decoded.end(), first_nonzero, data.cend());
+
+    bool started = false;
+    for (auto limb = limbs.rbegin(); limb != limbs.rend(); ++limb)
+    {
+        for (auto byte = base256_limb_bytes; byte > 0; --byte)
+        {
+            const auto value = static_cast<uint8_t>(*limb >> (8 * (byte - 1)));
+            if (value == 0 && !started)
+                continue;
+
+            started = true;
+            decoded.push_back(value);
+        }
+    }
 
     out = decoded;
     return true;
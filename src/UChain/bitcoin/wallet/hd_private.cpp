@@ -20,8 +20,11 @@
  */
 #include <UChain/bitcoin/wallet/hd_private.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <thread>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <UChain/bitcoin/constants.hpp>
 #include <UChain/bitcoin/define.hpp>
@@ -233,6 +236,12 @@ hd_public hd_private::to_public() const
 }
 
 hd_private hd_private::derive_private(uint32_t index) const
+{
+    return derive_child(index, fingerprint());
+}
+
+hd_private hd_private::derive_child(uint32_t index,
+    uint32_t fingerprint) const
 {
     constexpr uint8_t depth = 0;
 
@@ -254,13 +263,55 @@ hd_private hd_private::derive_private(uint32_t index) const
     {
         lineage_.prefixes,
         static_cast<uint8_t>(lineage_.depth + 1),
-        fingerprint(),
+        fingerprint,
         index
     };
 
     return hd_private(child, intermediate.right, lineage);
 }
 
+hd_private::list hd_private::derive_private(uint32_t first,
+    uint32_t count) const
+{
+    // The child index must not wrap.
+    if (count == 0 || first > max_uint32 - (count - 1))
+        return{};
+
+    // Shared by every child, so hash the parent point only once.
+    const auto parent = fingerprint();
+
+    list children(count);
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const size_t threads = std::min<size_t>(cores, count);
+    const size_t stride = (count + threads - 1) / threads;
+
+    // Each child is one hmac and one precomputed-table ec multiplication.
+    const auto derive = [&](size_t begin, size_t end)
+    {
+        for (auto offset = begin; offset < end; ++offset)
+            children[offset] = derive_child(
+                static_cast<uint32_t>(first + offset), parent);
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+
+    for (size_t begin = stride; begin < count; begin += stride)
+        workers.emplace_back(derive, begin, std::min<size_t>(begin + stride,
+            count));
+
+    derive(0, std::min<size_t>(stride, count));
+
+    for (auto& worker: workers)
+        worker.join();
+
+    const auto invalid = [](const hd_private& child) { return !child; };
+    if (std::any_of(children.begin(), children.end(), invalid))
+        return{};
+
+    return children;
+}
+
 hd_public hd_private::derive_public(uint32_t index) const
 {
     return derive_private(index).to_public();
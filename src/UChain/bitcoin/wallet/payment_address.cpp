@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <string>
+#include <tuple>
 #include <boost/program_options.hpp>
 #include <UChain/bitcoin/formats/base_58.hpp>
 #include <UChain/bitcoin/math/checksum.hpp>
@@ -194,7 +195,9 @@ payment_address& payment_address::operator=(const payment_address& other)
 
 bool payment_address::operator<(const payment_address& other) const
 {
-    return encoded() < other.encoded();
+    // Binary order, which avoids encoding either address.
+    return std::tie(valid_, version_, hash_) <
+        std::tie(other.valid_, other.version_, other.hash_);
 }
 
 bool payment_address::operator==(const payment_address& other) const
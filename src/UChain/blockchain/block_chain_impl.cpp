@@ -26,6 +26,9 @@
 #include <string>
 #include <algorithm>
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <unordered_map>
 #include <boost/filesystem.hpp>
@@ -34,7 +37,6 @@
 #include <UChainService/txs/token/token_cert.hpp>
 #include <UChain/database.hpp>
 #include <UChain/blockchain/block.hpp>
-#include <UChain/blockchain/block_fetcher.hpp>
 #include <UChain/blockchain/organizer.hpp>
 #include <UChain/blockchain/settings.hpp>
 #include <UChain/blockchain/transaction_pool.hpp>
@@ -43,7 +45,13 @@
 namespace libbitcoin {
 namespace blockchain {
 
-////#define NAME "blockchain"
+#define NAME "blockchain"
+
+// Reads for the network are spread over a small pool of their own.
+static const size_t minimum_read_threads = 2;
+
+// Previous outputs of a block are prefetched in slices of this many reads.
+static const size_t prefetch_slice_size = 32;
 
 using namespace bc::chain;
 using namespace bc::database;
@@ -57,7 +65,7 @@ block_chain_impl::block_chain_impl(threadpool& pool,
   : stopped_(true),
     settings_(chain_settings),
     organizer_(pool, *this, chain_settings),
-    ////read_dispatch_(pool, NAME),
+    read_dispatch_(read_pool_, NAME),
     ////write_dispatch_(pool, NAME),
     transaction_pool_(pool, *this, chain_settings),
     database_(database_settings)
@@ -85,6 +93,28 @@ static hash_list to_hashes(const block_result& result)
     return hashes;
 }
 
+// Read the transactions of a block under the caller's read handle.
+static block::ptr to_block(const block_result& result,
+    const transaction_database& transactions)
+{
+    const auto count = result.transaction_count();
+    const auto out = std::make_shared<block>();
+    out->header = result.header();
+    out->header.transaction_count = count;
+    out->transactions.reserve(count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto tx = transactions.get(result.transaction_hash(index));
+        if (!tx)
+            return nullptr;
+
+        out->transactions.push_back(tx.transaction());
+    }
+
+    return out;
+}
+
 // Properties.
 // ----------------------------------------------------------------------------
 
@@ -107,6 +137,16 @@ bool block_chain_impl::start()
     if (!stopped() || !database_.start())
         return false;
 
+    headers_.clear();
+    index_headers();
+
+    // Joining first allows the read pool to restart after a stop.
+    const auto cores = static_cast<size_t>(std::thread::hardware_concurrency());
+    read_pool_.join();
+    read_pool_.spawn(std::max(minimum_read_threads, cores / 2));
+    prefetch_pool_.join();
+    prefetch_pool_.spawn(std::max(minimum_read_threads, cores / 2));
+
     stopped_ = false;
     organizer_.start();
     transaction_pool_.start();
@@ -123,12 +163,19 @@ bool block_chain_impl::stop()
     stopped_ = true;
     organizer_.stop();
     transaction_pool_.stop();
+    read_pool_.shutdown();
+    prefetch_pool_.shutdown();
     return database_.stop();
 }
 
 // Database threads must be joined before close is called (or destruct).
 bool block_chain_impl::close()
 {
+    // Queued reads are allowed to complete before the database is closed.
+    read_pool_.shutdown();
+    read_pool_.join();
+    prefetch_pool_.shutdown();
+    prefetch_pool_.join();
     return database_.close();
 }
 
@@ -191,6 +238,10 @@ bool block_chain_impl::get_difficulty(u256& out_difficulty,
     if (!database_.blocks.top(top))
         return false;
 
+    // The index holds cumulative work, so this is constant time without gaps.
+    if (top < headers_.size())
+        return headers_.get_work(out_difficulty, height);
+
     out_difficulty = 0;
     for (uint64_t index = height; index <= top; ++index)
     {
@@ -211,6 +262,12 @@ bool block_chain_impl::get_header(header& out_header, uint64_t height) const
     return true;
 }
 
+bool block_chain_impl::get_header_entry(header_index::entry& out_entry,
+    uint64_t height) const
+{
+    return headers_.get(out_entry, height);
+}
+
 bool block_chain_impl::get_height(uint64_t& out_height,
     const hash_digest& block_hash) const
 {
@@ -257,6 +314,90 @@ bool block_chain_impl::get_transaction(transaction& out_transaction,
     return true;
 }
 
+// This is called by the organizer while verifying a block, inside the write
+// section of do_store. Blocks are verified and pushed serially on that one
+// thread, so no write overlaps these reads and they do not take the sequence
+// lock. The read pool is avoided because its queued reads wait on that same
+// write lock. The caller claims slices alongside the pool threads, so
+// completion never depends upon the pool running the helpers.
+void block_chain_impl::get_transactions(transaction_map& out_transactions,
+    const hash_list& hashes)
+{
+    BITCOIN_ASSERT_MSG(database_.is_write_locked(database_.begin_read()),
+        "prefetch outside of the organizer write section");
+
+    struct prefetch_state
+    {
+        std::atomic<size_t> next;
+        size_t active;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    const auto count = hashes.size();
+    const auto slices = (count + prefetch_slice_size - 1) / prefetch_slice_size;
+    std::vector<transaction_map> results(slices);
+    const auto state = std::make_shared<prefetch_state>();
+    state->next = 0;
+    state->active = 0;
+
+    const auto read_slice = [this, &hashes, &results, count](size_t slice)
+    {
+        const auto begin = slice * prefetch_slice_size;
+        const auto end = std::min(count, begin + prefetch_slice_size);
+        auto& result = results[slice];
+        result.reserve(end - begin);
+
+        for (auto index = begin; index < end; ++index)
+        {
+            const auto& hash = hashes[index];
+            const auto found = database_.transactions.get(hash);
+            if (found)
+                result.emplace(hash,
+                    std::make_pair(found.transaction(), found.height()));
+        }
+    };
+
+    const auto claim_slices = [state, slices, &read_slice]()
+    {
+        for (auto slice = state->next++; slice < slices;
+            slice = state->next++)
+            read_slice(slice);
+    };
+
+    // Helpers that start after all slices are claimed touch nothing else.
+    const auto helper = [state, slices, claim_slices]()
+    {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->next >= slices)
+                return;
+
+            ++state->active;
+        }
+
+        claim_slices();
+
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (--state->active == 0)
+            state->done.notify_one();
+    };
+
+    if (!stopped())
+        for (size_t slice = 1; slice < slices; ++slice)
+            prefetch_pool_.service().post(helper);
+
+    claim_slices();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [state]() { return state->active == 0; });
+    lock.unlock();
+
+    for (auto& result: results)
+        out_transactions.insert(std::make_move_iterator(result.begin()),
+            std::make_move_iterator(result.end()));
+}
+
 // This is safe to call concurrently (but with no other methods).
 bool block_chain_impl::import(block::ptr block, uint64_t height)
 {
@@ -265,12 +406,14 @@ bool block_chain_impl::import(block::ptr block, uint64_t height)
 
     // THIS IS THE DATABASE BLOCK WRITE AND INDEX OPERATION.
     database_.push(*block, height);
+    index_headers();
     return true;
 }
 
 bool block_chain_impl::push(block_detail::ptr block)
 {
     database_.push(*block->actual());
+    index_headers();
     return true;
 }
 
@@ -302,9 +445,23 @@ bool block_chain_impl::pop_from(block_detail::list& out_blocks,
         out_blocks.push_back(block);
     }
 
+    headers_.pop_from(height);
     return true;
 }
 
+// Imports may arrive out of order, so each write extends the index over
+// any blocks stored above it. Concurrent callers stop at the first entry
+// that another has already indexed.
+void block_chain_impl::index_headers()
+{
+    for (auto height = headers_.size(); ; ++height)
+    {
+        const auto result = database_.blocks.get(height);
+        if (!result || !headers_.push(result.header(), height))
+            return;
+    }
+}
+
 // block_chain (internal locks).
 // ----------------------------------------------------------------------------
 
@@ -404,26 +561,27 @@ void block_chain_impl::fetch_serial(perform_read_functor perform_read)
     do_read();
 }
 
-////void block_chain_impl::fetch_parallel(perform_read_functor perform_read)
-////{
-////    // Post IBD writes are ordered on the strand, so never concurrent.
-////    // Reads are unordered and concurrent, but effectively blocked by writes.
-////    const auto try_read = [this, perform_read]()
-////    {
-////        const auto handle = database_.begin_read();
-////        return (!database_.is_write_locked(handle) && perform_read(handle));
-////    };
-////
-////    const auto do_read = [this, try_read]()
-////    {
-////        // Sleep while waiting for write to complete.
-////        while (!try_read())
-////            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-////    };
-////
-////    // Initiate async read operation.
-////    read_dispatch_.concurrent(do_read);
-////}
+// This performs a query on the read pool, the handler is invoked there.
+void block_chain_impl::fetch_parallel(perform_read_functor perform_read)
+{
+    // Post IBD writes are ordered on the strand, so never concurrent.
+    // Reads are unordered and concurrent, but effectively blocked by writes.
+    const auto try_read = [this, perform_read]()
+    {
+        const auto handle = database_.begin_read();
+        return (!database_.is_write_locked(handle) && perform_read(handle));
+    };
+
+    const auto do_read = [try_read]()
+    {
+        // Sleep while waiting for write to complete.
+        while (!try_read())
+            std::this_thread::sleep_for(asio::milliseconds(10));
+    };
+
+    // Initiate async read operation.
+    read_dispatch_.concurrent(do_read);
+}
 
 ////// TODO: This should be ordered on the channel's strand, not across channels.
 ////void block_chain_impl::fetch_ordered(perform_read_functor perform_read)
@@ -472,7 +630,8 @@ void block_chain_impl::fetch_block_locator(block_locator_fetch_handler handler)
         for (const auto index: indexes)
         {
             hash_digest hash;
-            auto found = false;
+            auto found = headers_.get_hash(hash, index);
+            if (!found)
             {
                 const auto result = database_.blocks.get(index);
                 if (result)
@@ -547,6 +706,13 @@ void block_chain_impl::fetch_locator_block_hashes(
         hash_list hashes;
         for (size_t index = start + 1; index < stop; ++index)
         {
+            hash_digest hash;
+            if (headers_.get_hash(hash, index))
+            {
+                hashes.push_back(hash);
+                continue;
+            }
+
             const auto result = database_.blocks.get(index);
             if (result)
             {
@@ -557,7 +723,7 @@ void block_chain_impl::fetch_locator_block_hashes(
 
         return finish_fetch(slock, handler, error::success, hashes);
     };
-    fetch_serial(do_fetch);
+    fetch_parallel(do_fetch);
 }
 
 void block_chain_impl::fetch_locator_block_headers(
@@ -626,7 +792,7 @@ void block_chain_impl::fetch_locator_block_headers(
 
         return finish_fetch(slock, handler, error::success, headers);
     };
-    fetch_serial(do_fetch);
+    fetch_parallel(do_fetch);
 }
 
 // This may execute up to 500 queries.
@@ -691,16 +857,47 @@ void block_chain_impl::filter_orphans(message::get_data::ptr message,
 // block_chain (formerly fetch_parallel)
 // ------------------------------------------------------------------------
 
+// The block is read in one pass rather than one query per transaction.
 void block_chain_impl::fetch_block(uint64_t height,
     block_fetch_handler handler)
 {
-    blockchain::fetch_block(*this, height, handler);
+    if (stopped())
+    {
+        handler(error::service_stopped, nullptr);
+        return;
+    }
+
+    const auto do_fetch = [this, height, handler](size_t slock)
+    {
+        const auto result = database_.blocks.get(height);
+        const auto out = result ? to_block(result, database_.transactions) :
+            nullptr;
+        return out ?
+            finish_fetch(slock, handler, error::success, out) :
+            finish_fetch(slock, handler, error::not_found, nullptr);
+    };
+    fetch_parallel(do_fetch);
 }
 
 void block_chain_impl::fetch_block(const hash_digest& hash,
     block_fetch_handler handler)
 {
-    blockchain::fetch_block(*this, hash, handler);
+    if (stopped())
+    {
+        handler(error::service_stopped, nullptr);
+        return;
+    }
+
+    const auto do_fetch = [this, hash, handler](size_t slock)
+    {
+        const auto result = database_.blocks.get(hash);
+        const auto out = result ? to_block(result, database_.transactions) :
+            nullptr;
+        return out ?
+            finish_fetch(slock, handler, error::success, out) :
+            finish_fetch(slock, handler, error::not_found, nullptr);
+    };
+    fetch_parallel(do_fetch);
 }
 
 void block_chain_impl::fetch_block_header(uint64_t height,
@@ -902,6 +1099,35 @@ void block_chain_impl::fetch_transaction(const hash_digest& hash,
     fetch_serial(do_fetch);
 }
 
+void block_chain_impl::fetch_transactions(const hash_list& hashes,
+    transactions_fetch_handler handler)
+{
+    if (stopped())
+    {
+        handler(error::service_stopped, {}, {});
+        return;
+    }
+
+    const auto do_fetch = [this, hashes, handler](size_t slock)
+    {
+        chain::transaction::list txs;
+        hash_list missing;
+        txs.reserve(hashes.size());
+
+        for (const auto& hash: hashes)
+        {
+            const auto result = database_.transactions.get(hash);
+            if (result)
+                txs.push_back(result.transaction());
+            else
+                missing.push_back(hash);
+        }
+
+        return finish_fetch(slock, handler, error::success, txs, missing);
+    };
+    fetch_parallel(do_fetch);
+}
+
 void block_chain_impl::fetch_transaction_index(const hash_digest& hash,
     transaction_index_fetch_handler handler)
 {
@@ -963,6 +1189,31 @@ void block_chain_impl::fetch_history(const wallet::payment_address& address,
     fetch_serial(do_fetch);
 }
 
+void block_chain_impl::fetch_histories(
+    const std::vector<wallet::payment_address>& addresses, uint64_t limit,
+    uint64_t from_height, histories_fetch_handler handler)
+{
+    if (stopped())
+    {
+        handler(error::service_stopped, {});
+        return;
+    }
+
+    const auto do_fetch = [this, addresses, handler, limit, from_height](
+        size_t slock)
+    {
+        std::vector<history_compact::list> histories;
+        histories.reserve(addresses.size());
+
+        for (const auto& address: addresses)
+            histories.push_back(database_.history.get(address.hash(), limit,
+                from_height));
+
+        return finish_fetch(slock, handler, error::success, histories);
+    };
+    fetch_parallel(do_fetch);
+}
+
 bool block_chain_impl::fetch_history(const wallet::payment_address& address,
     uint64_t limit, uint64_t from_height, history_compact::list& history)
 {
@@ -1538,16 +1789,15 @@ uint64_t block_chain_impl::get_address_token_volume(const std::string& addr, con
     auto address = payment_address(addr);
     auto&& rows = get_address_history(address);
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    bool is_coinbase;
 
     for (auto& row: rows)
     {
         // spend unconfirmed (or no spend attempted)
         if ((row.spend.hash == null_hash)
-            && get_transaction(tx_temp, tx_height, row.output.hash))
+            && get_output(row.output, output, is_coinbase))
         {
-            auto output = tx_temp.outputs.at(row.output.index);
             if ((output.is_token_transfer() || output.is_token_issue() || output.is_token_secondaryissue())) {
                 if (output.get_token_symbol() == token) {
                     token_volume += output.get_token_amount();
@@ -2205,6 +2455,36 @@ bool block_chain_impl::get_transaction(const hash_digest& hash,
     return ret;
 }
 
+// Stored records with an output table are read without a full decode, older
+// records and pooled transactions fall back to the transaction read.
+bool block_chain_impl::get_output(const chain::output_point& point,
+    chain::output& output, bool& is_coinbase)
+{
+    if (stopped())
+        return false;
+
+    const auto result = database_.transactions.get(point.hash);
+    if (result && result.has_output_table())
+    {
+        if (point.index >= result.output_count())
+            return false;
+
+        output = result.output(point.index);
+        is_coinbase = result.is_coinbase();
+        return true;
+    }
+
+    chain::transaction tx;
+    uint64_t tx_height;
+    if (!get_transaction(point.hash, tx, tx_height) ||
+        point.index >= tx.outputs.size())
+        return false;
+
+    output = tx.outputs[point.index];
+    is_coinbase = tx.is_coinbase();
+    return true;
+}
+
 bool block_chain_impl::get_transaction_callback(const hash_digest& hash,
     std::function<void(const code&, const chain::transaction&)> handler)
 {
@@ -2456,8 +2736,14 @@ void block_chain_impl::safe_store_account(account& acc, std::vector<std::shared_
     if (stopped())
         return;
 
+    // batches normally belong to one account, hash its name only once.
+    std::string name;
+    short_hash hash;
     for(auto& address:addresses) {
-        const auto hash = get_short_hash(address->get_name());
+        if (name.empty() || address->get_name() != name) {
+            name = address->get_name();
+            hash = get_short_hash(name);
+        }
         database_.account_addresses.safe_store(hash, *address);
     }
     database_.account_addresses.sync();
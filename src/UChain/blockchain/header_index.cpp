@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers 
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/blockchain/header_index.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <UChain/bitcoin.hpp>
+#include <UChain/blockchain/block.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+// Entries are about 100 bytes, reserve at least this many at a time.
+static constexpr size_t reserve_step = 100000;
+
+bool header_index::push(const chain::header& header, size_t height)
+{
+    const auto work = block_work(header.bits);
+    const auto hash = header.hash();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    if (height != entries_.size())
+        return false;
+
+    // Growth is geometric, so the copying is amortized over the pushes.
+    if (entries_.size() == entries_.capacity())
+        entries_.reserve(std::max(entries_.size() * 2,
+            entries_.size() + reserve_step));
+
+    const auto total = entries_.empty() ? work : entries_.back().work + work;
+    entries_.push_back({ hash, header.bits, header.timestamp, header.version,
+        total });
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void header_index::pop_from(size_t height)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    if (height < entries_.size())
+        entries_.resize(height);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void header_index::clear()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+    entries_.clear();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t header_index::size() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+    return entries_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool header_index::get(entry& out_entry, size_t height) const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+
+    if (height >= entries_.size())
+        return false;
+
+    out_entry = entries_[height];
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool header_index::get_hash(hash_digest& out_hash, size_t height) const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+
+    if (height >= entries_.size())
+        return false;
+
+    out_hash = entries_[height].hash;
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool header_index::get_work(u256& out_work, size_t height) const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+
+    if (entries_.empty() || height > entries_.size())
+        return false;
+
+    const auto& top = entries_.back().work;
+    out_work = height == 0 ? top : top - entries_[height - 1].work;
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace blockchain
+} // namespace libbitcoin
@@ -28,36 +28,47 @@ namespace libbitcoin {
 namespace blockchain {
 
 orphan_pool::orphan_pool(size_t capacity)
+  : capacity_(capacity == 0 ? 1 : capacity),
+    sequence_(0)
 {
-    buffer_.reserve(capacity == 0 ? 1 : capacity);
+    blocks_.reserve(capacity_);
 }
 
 // There is no validation whatsoever of the block up to this pont.
 bool orphan_pool::add(block_detail::ptr block)
 {
     const auto& header = block->actual()->header;
+    const auto hash = block->hash();
 
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     mutex_.lock_upgrade();
 
     // No duplicates allowed.
-    if (exists(header))
+    if (exists(hash))
     {
         mutex_.unlock_upgrade();
         //-----------------------------------------------------------------
         return false;
     }
 
-    const auto old_size = buffer_.size();
+    const auto old_size = blocks_.size();
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     mutex_.unlock_upgrade_and_lock();
-    buffer_.push_back(block);
+
+    if (blocks_.size() >= capacity_)
+        evict();
+
+    const auto sequence = sequence_++;
+    blocks_.emplace(hash, entry{ block, sequence });
+    children_.emplace(header.previous_block_hash, hash);
+    arrivals_.emplace(sequence, block);
+
     mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
 
     log::debug(LOG_BLOCKCHAIN)
-        << "Orphan pool added block [" << encode_hash(block->hash())
+        << "Orphan pool added block [" << encode_hash(hash)
         << "] previous [" << encode_hash(header.previous_block_hash)
         << "] old size (" << old_size << ").";
 
@@ -66,32 +77,33 @@ bool orphan_pool::add(block_detail::ptr block)
 
 void orphan_pool::remove(block_detail::ptr block)
 {
+    const auto hash = block->hash();
+
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     mutex_.lock_upgrade();
 
-    const auto it = std::find(buffer_.begin(), buffer_.end(), block);
+    const auto it = blocks_.find(hash);
 
-    if (it == buffer_.end())
+    if (it == blocks_.end() || it->second.block != block)
     {
         mutex_.unlock_upgrade();
         //-----------------------------------------------------------------
         return;
     }
 
-    const auto old_size = buffer_.size();
+    const auto old_size = blocks_.size();
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     mutex_.unlock_upgrade_and_lock();
-    buffer_.erase(it);
+    erase(hash);
     mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
 
     log::debug(LOG_BLOCKCHAIN)
-        << "Orphan pool removed block [" << encode_hash(block->hash())
+        << "Orphan pool removed block [" << encode_hash(hash)
         << "] old size (" << old_size << "). with status: " << block->error().message();
 }
 
-// TODO: use hash table pool to eliminate this O(n^2) search.
 void orphan_pool::filter(message::get_data::ptr message) const
 {
     auto& inventories = message->inventories;
@@ -108,10 +120,10 @@ void orphan_pool::filter(message::get_data::ptr message) const
     ///////////////////////////////////////////////////////////////////////////
 }
 
+// Each step is a hash lookup, so this is linear in the length of the chain.
 block_detail::list orphan_pool::trace(block_detail::ptr end) const
 {
     block_detail::list trace;
-    trace.reserve(buffer_.size());
     trace.push_back(end);
     auto hash = end->actual()->header.previous_block_hash;
 
@@ -119,10 +131,15 @@ block_detail::list orphan_pool::trace(block_detail::ptr end) const
     // Critical Section
     mutex_.lock_shared();
 
-    for (auto it = rfind(buffer_.rbegin(), hash); it != buffer_.rend(); it = rfind(it, hash))
+    for (auto it = blocks_.find(hash); it != blocks_.end();
+        it = blocks_.find(hash))
     {
-        trace.push_back(*it);
-        hash = (*it)->actual()->header.previous_block_hash;
+        // Guard against a cycle, which is not possible with valid hashes.
+        if (trace.size() > blocks_.size())
+            break;
+
+        trace.push_back(it->second.block);
+        hash = it->second.block->actual()->header.previous_block_hash;
     }
 
     mutex_.unlock_shared();
@@ -130,23 +147,55 @@ block_detail::list orphan_pool::trace(block_detail::ptr end) const
 
     BITCOIN_ASSERT(!trace.empty());
     std::reverse(trace.begin(), trace.end());
-    trace.shrink_to_fit();
     return trace;
 }
 
+block_detail::list orphan_pool::children(const hash_digest& hash) const
+{
+    block_detail::list children;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+
+    const auto range = children_.equal_range(hash);
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const auto child = blocks_.find(it->second);
+
+        if (child != blocks_.end())
+            children.push_back(child->second.block);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    return children;
+}
+
+size_t orphan_pool::size() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+
+    return blocks_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 block_detail::list orphan_pool::unprocessed() const
 {
     block_detail::list unprocessed;
-    unprocessed.reserve(buffer_.size());
 
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     mutex_.lock_shared();
 
+    unprocessed.reserve(arrivals_.size());
+
     // Earlier blocks enter pool first, so reversal helps avoid fragmentation.
-    for (auto it = buffer_.rbegin(); it != buffer_.rend(); ++it)
-        if (!(*it)->processed())
-            unprocessed.push_back(*it);
+    for (auto it = arrivals_.rbegin(); it != arrivals_.rend(); ++it)
+        if (!it->second->processed())
+            unprocessed.push_back(it->second);
 
     mutex_.unlock_shared();
     ///////////////////////////////////////////////////////////////////////////
@@ -187,44 +236,47 @@ block_detail::ptr orphan_pool::delete_pending_block(const hash_digest& needed_bl
 
 bool orphan_pool::exists(const hash_digest& hash) const
 {
-    const auto match = [&hash](const block_detail::ptr& entry)
-    {
-        return hash == entry->hash();
-    };
-
-    return std::any_of(buffer_.begin(), buffer_.end(), match);
+    return blocks_.find(hash) != blocks_.end();
 }
 
-bool orphan_pool::exists(const chain::header& header) const
+// Remove the block of the given hash from all indexes (not locked).
+void orphan_pool::erase(const hash_digest& hash)
 {
-    const auto match = [&header](const block_detail::ptr& entry)
-    {
-        return header == entry->actual()->header;
-    };
+    const auto it = blocks_.find(hash);
 
-    return std::any_of(buffer_.begin(), buffer_.end(), match);
-}
+    if (it == blocks_.end())
+        return;
 
-/*
-orphan_pool::const_iterator orphan_pool::find(buffer::const_iterator begin, const hash_digest& hash) const
-{
-    const auto match = [&hash](const block_detail::ptr& entry)
+    const auto& header = it->second.block->actual()->header;
+    const auto sequence = it->second.sequence;
+    const auto range = children_.equal_range(header.previous_block_hash);
+
+    for (auto child = range.first; child != range.second; ++child)
     {
-        return hash == entry->hash();
-    };
+        if (child->second == hash)
+        {
+            children_.erase(child);
+            break;
+        }
+    }
 
-    return std::find_if(begin, buffer_.end(), match);
+    arrivals_.erase(sequence);
+    blocks_.erase(it);
 }
-*/
 
-orphan_pool::const_reverse_iterator orphan_pool::rfind(buffer::const_reverse_iterator begin, const hash_digest& hash) const
+// Orphan heights are peer supplied and unvalidated, so they cannot rank
+// eviction. The oldest arrival is evicted first (not locked).
+void orphan_pool::evict()
 {
-    const auto match = [&hash](const block_detail::ptr& entry)
-    {
-        return hash == entry->hash();
-    };
+    if (arrivals_.empty())
+        return;
+
+    const auto hash = arrivals_.begin()->second->hash();
+
+    log::debug(LOG_BLOCKCHAIN)
+        << "Orphan pool evicted block [" << encode_hash(hash) << "].";
 
-    return std::find_if(begin, buffer_.rend(), match);
+    erase(hash);
 }
 
 } // namespace blockchain
@@ -93,66 +93,184 @@ void transaction_pool::inventory(message::inventory::ptr inventory)
     ///////////////////////////////////////////////////////////////////////////
 }
 
+// Validation runs concurrently up to handle_validated, which is ordered so
+// that the final pool checks and insertion are serialized.
 void transaction_pool::validate(transaction_ptr tx, validate_handler handler)
 {
-    dispatch_.ordered(&transaction_pool::do_validate,
-                      this, tx, handler);
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock();
+    ++validating_[tx->hash()];
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    dispatch_.concurrent(&transaction_pool::do_validate,
+                         this, tx, false, handler);
 }
 
-void transaction_pool::do_validate(transaction_ptr tx,
+void transaction_pool::do_validate(transaction_ptr tx, bool retried,
                                    validate_handler handler)
 {
+    // Completion reads waiting_, so it is always ordered.
     if (stopped())
     {
-        handler(error::service_stopped, tx, {});
+        dispatch_.ordered(&transaction_pool::handle_validated, this,
+            code(error::service_stopped), tx, indexes{}, false, handler);
         return;
     }
 
     const auto validate = std::make_shared<validate_transaction>(
                               blockchain_, *tx, *this, dispatch_);
 
+    // Whether the missing parent was still being validated is sampled at
+    // failure, as it may have finished by the time the completion is ordered.
     validate->start(
-        dispatch_.ordered_delegate(&transaction_pool::handle_validated,
-                                   this, _1, _2, _3, handler));
+        [this, retried, handler](const code& ec, transaction_ptr tx,
+            const indexes& unconfirmed)
+        {
+            const auto deferrable = !retried &&
+                is_parent_validating(ec, tx, unconfirmed);
+
+            dispatch_.ordered(&transaction_pool::handle_validated, this,
+                ec, tx, unconfirmed, deferrable, handler);
+        });
 }
 
 void transaction_pool::handle_validated(const code& ec, transaction_ptr tx,
-                                        const indexes& unconfirmed, validate_handler handler)
+                                        const indexes& unconfirmed, bool deferrable,
+                                        validate_handler handler)
 {
+    if (defer_validated(ec, tx, unconfirmed, deferrable, handler))
+        return;
+
+    const auto complete = [this, tx, handler](const code& ec,
+        const indexes& unconfirmed)
+    {
+        // The handler stores a valid tx, so dependents are released after.
+        handler(ec, tx, unconfirmed);
+        finish_validated(tx);
+    };
+
     if (stopped())
     {
-        handler(error::service_stopped, tx, {});
+        complete(error::service_stopped, {});
         return;
     }
 
     if (ec == (code)error::input_not_found || ec == (code)error::validate_inputs_failed)
     {
         BITCOIN_ASSERT(unconfirmed.size() == 1);
-        handler(ec, tx, unconfirmed);
+        complete(ec, unconfirmed);
         return;
     }
 
     if (ec)
     {
         BITCOIN_ASSERT(unconfirmed.empty());
-        handler(ec, tx, {});
+        complete(ec, {});
         return;
     }
 
     // Recheck the memory pool, as a duplicate may have been added.
     if (is_in_pool(tx->hash()))
     {
-        handler(error::duplicate, tx, {});
+        complete(error::duplicate, {});
+        return;
+    }
+
+    // Recheck spends, as a concurrently validated tx may have been added.
+    if (is_spent_in_pool(tx))
+    {
+        complete(error::double_spend, {});
         return;
     }
 
     code error = check_symbol_repeat(tx);
     if (error != error::success) {
-        handler(error, tx, {});
+        complete(error, {});
         return;
     }
 
-    handler(error::success, tx, unconfirmed);
+    complete(error::success, unconfirmed);
+}
+
+// The failing input is named by the validator, which is not always the input
+// that was missing, so this is only a hint for deferral.
+bool transaction_pool::is_parent_validating(const code& ec,
+    transaction_ptr tx, const indexes& unconfirmed) const
+{
+    if (ec != (code)error::input_not_found || unconfirmed.size() != 1 ||
+        unconfirmed.front() >= tx->inputs.size())
+        return false;
+
+    const auto& parent = tx->inputs[unconfirmed.front()].previous_output.hash;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+    return validating_.find(parent) != validating_.end();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// A tx that failed while its parent was being validated is retried once the
+// parent is resolved, as sequential validation would have allowed. A tx is
+// retried at most once, so a missing parent cannot cause repeated validation.
+bool transaction_pool::defer_validated(const code& ec, transaction_ptr tx,
+    const indexes& unconfirmed, bool deferrable, validate_handler handler)
+{
+    if (!deferrable || stopped())
+        return false;
+
+    const auto& prevout = tx->inputs[unconfirmed.front()].previous_output;
+    const auto& parent = prevout.hash;
+
+    // The parent finished after the failure, retry if it provides the output.
+    transaction_ptr parent_tx;
+    if (find(parent_tx, parent))
+    {
+        if (prevout.index >= parent_tx->outputs.size())
+            return false;
+
+        dispatch_.concurrent(&transaction_pool::do_validate,
+                             this, tx, true, handler);
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+    if (validating_.find(parent) == validating_.end())
+        return false;
+    ///////////////////////////////////////////////////////////////////////////
+
+    waiting_.emplace(parent, deferred{ tx, handler });
+    return true;
+}
+
+void transaction_pool::finish_validated(transaction_ptr tx)
+{
+    const auto hash = tx->hash();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock();
+    const auto it = validating_.find(hash);
+    BITCOIN_ASSERT(it != validating_.end());
+    if (--it->second == 0)
+        validating_.erase(it);
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    const auto range = waiting_.equal_range(hash);
+    std::vector<deferred> children;
+    for (auto it = range.first; it != range.second; ++it)
+        children.push_back(it->second);
+
+    waiting_.erase(range.first, range.second);
+
+    for (const auto& child: children)
+        dispatch_.concurrent(&transaction_pool::do_validate,
+                             this, child.tx, true, child.handler);
 }
 
 code transaction_pool::check_symbol_repeat(transaction_ptr tx)
@@ -377,7 +495,12 @@ void transaction_pool::delete_tx(const hash_digest& tx_hash)
             if (item->tx->hash() == tx_hash)
             {
                 log::debug(LOG_BLOCKCHAIN) << " delete_tx hash:" << libbitcoin::encode_hash(tx_hash) << " success";
+
+                ///////////////////////////////////////////////////////////////
+                // Critical Section
+                unique_lock lock(mutex_);
                 buffer_.erase(item);
+                ///////////////////////////////////////////////////////////////
                 break;
             }
         }
@@ -528,7 +651,11 @@ void transaction_pool::add(transaction_ptr tx, confirm_handler handler)
     if (maintain_consistency_ && buffer_.size() == buffer_.capacity())
         delete_package(error::pool_filled);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
     buffer_.push_back({ tx, handler });
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 // There has been a reorg, clear the memory pool using the given reason code.
@@ -537,7 +664,11 @@ void transaction_pool::clear(const code& ec)
     for (const auto& entry : buffer_)
         entry.handle_confirm(ec, entry.tx);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
     buffer_.clear();
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 // Delete memory pool txs that are obsoleted by a new block acceptance.
@@ -656,7 +787,7 @@ bool transaction_pool::delete_single(const hash_digest& tx_hash, const code& ec)
         return false;
 
     it->handle_confirm(ec, it->tx);
-    buffer_.erase(it);
+    erase(it);
 
     while (1) {
         const auto it = std::find_if(buffer_.begin(), buffer_.end(), matched);
@@ -665,15 +796,27 @@ bool transaction_pool::delete_single(const hash_digest& tx_hash, const code& ec)
             break;
 
         it->handle_confirm(ec, it->tx);
-        buffer_.erase(it);
+        erase(it);
     }
 
     return true;
 }
 
+void transaction_pool::erase(buffer::iterator it)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+    buffer_.erase(it);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 bool transaction_pool::find(transaction_ptr& out_tx,
                             const hash_digest& tx_hash) const
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
     const auto it = find(tx_hash);
     const auto found = it != buffer_.end();
 
@@ -686,6 +829,9 @@ bool transaction_pool::find(transaction_ptr& out_tx,
 bool transaction_pool::find(chain::transaction& out_tx,
                             const hash_digest& tx_hash) const
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
     const auto it = find(tx_hash);
     const auto found = it != buffer_.end();
 
@@ -711,7 +857,11 @@ transaction_pool::const_iterator transaction_pool::find(
 
 bool transaction_pool::is_in_pool(const hash_digest& tx_hash) const
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
     return find(tx_hash) != buffer_.end();
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 bool transaction_pool::is_spent_in_pool(transaction_ptr tx) const
@@ -723,14 +873,27 @@ bool transaction_pool::is_spent_in_pool(const transaction& tx) const
 {
     const auto found = [this](const input & input)
     {
-        return is_spent_in_pool(input.previous_output);
+        return is_spent(input.previous_output);
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
     const auto& inputs = tx.inputs;
     return std::any_of(inputs.begin(), inputs.end(), found);
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 bool transaction_pool::is_spent_in_pool(const output_point& outpoint) const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+    return is_spent(outpoint);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool transaction_pool::is_spent(const output_point& outpoint) const
 {
     const auto found = [&outpoint](const entry & entry)
     {
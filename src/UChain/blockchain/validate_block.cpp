@@ -26,6 +26,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <system_error>
+#include <unordered_set>
 #include <vector>
 #include <UChain/bitcoin.hpp>
 #include <UChain/blockchain/block.hpp>
@@ -582,6 +583,26 @@ code validate_block::connect_block(hash_digest& err_tx, blockchain::block_chain_
         }
     }
 
+    // Resolve the previous transactions of all inputs before the input loop.
+    hash_list previous_hashes;
+    std::unordered_set<hash_digest> block_hashes;
+    for (const auto& tx : transactions)
+        block_hashes.insert(tx.hash());
+
+    for (const auto& tx : transactions)
+    {
+        if (tx.is_coinbase())
+            continue;
+
+        // Parents within this block are not yet stored.
+        for (const auto& input : tx.inputs)
+            if (block_hashes.insert(input.previous_output.hash).second)
+                previous_hashes.push_back(input.previous_output.hash);
+    }
+
+    prefetch_transactions(previous_hashes);
+    RETURN_IF_STOPPED();
+
     uint64_t fees = 0;
     size_t total_sigops = 0;
     const auto count = transactions.size();
@@ -710,6 +731,10 @@ bool validate_block::script_hash_signature_operations_count(size_t& out_count,
     return true;
 }
 
+void validate_block::prefetch_transactions(const hash_list&) const
+{
+}
+
 bool validate_block::get_transaction(const hash_digest& tx_hash,
                                      chain::transaction& prev_tx, size_t& prev_height) const
 {
@@ -63,7 +63,7 @@ bool validate_block_impl::is_valid_proof_of_work(const chain::header& header) co
 u256 validate_block_impl::previous_block_bits() const
 {
     // Read block header (top - 1) and return bits
-    return fetch_block(height_ - 1).bits;
+    return fetch_header(height_ - 1).bits;
 }
 
 validate_block::versions validate_block_impl::preceding_block_versions(
@@ -78,7 +78,7 @@ validate_block::versions validate_block_impl::preceding_block_versions(
     versions result;
     for (size_t index = 0; index < size; ++index)
     {
-        const auto version = fetch_block(height_ - index - 1).version;
+        const auto version = fetch_header(height_ - index - 1).version;
 
         // Some blocks have high versions, see block #390777.
         static const auto maximum = static_cast<uint32_t>(max_uint8);
@@ -94,7 +94,7 @@ uint64_t validate_block_impl::actual_time_span(size_t interval) const
     BITCOIN_ASSERT(height_ > 0 && height_ >= interval);
 
     // height - interval and height - 1, return time difference
-    return fetch_block(height_ - 1).timestamp - fetch_block(height_ - interval).timestamp;
+    return fetch_header(height_ - 1).timestamp - fetch_header(height_ - interval).timestamp;
 }
 
 uint64_t validate_block_impl::median_time_past() const
@@ -104,7 +104,7 @@ uint64_t validate_block_impl::median_time_past() const
 
     std::vector<uint64_t> times;
     for (size_t i = 0; i < count; ++i)
-        times.push_back(fetch_block(height_ - i - 1).timestamp);
+        times.push_back(fetch_header(height_ - i - 1).timestamp);
 
     // Sort and select middle (median) value from the array.
     std::sort(times.begin(), times.end());
@@ -126,6 +126,30 @@ chain::header validate_block_impl::fetch_block(size_t fetch_height) const
     return out;
 }
 
+// Only the contextual fields are used, the hash and work are not set.
+static header_index::entry to_entry(const chain::header& header)
+{
+    return { null_hash, header.bits, header.timestamp, header.version, 0 };
+}
+
+header_index::entry validate_block_impl::fetch_header(
+    size_t fetch_height) const
+{
+    if (fetch_height > fork_index_)
+    {
+        const auto fetch_index = fetch_height - fork_index_ - 1;
+        BITCOIN_ASSERT(fetch_index <= orphan_index_);
+        return to_entry(orphan_chain_[fetch_index]->actual()->header);
+    }
+
+    // Blocks below the first chain gap are served from memory.
+    header_index::entry out;
+    if (chain_.get_header_entry(out, fetch_height))
+        return out;
+
+    return to_entry(fetch_block(fetch_height));
+}
+
 bool tx_after_fork(size_t tx_height, size_t fork_index)
 {
     return tx_height > fork_index;
@@ -156,9 +180,34 @@ bool validate_block_impl::is_output_spent(
     return transaction_exists(out_hash);
 }
 
+void validate_block_impl::prefetch_transactions(
+    const hash_list& tx_hashes) const
+{
+    prefetched_.clear();
+    chain_.get_transactions(prefetched_, tx_hashes);
+
+    // Transactions above the fork point are resolved from the orphan chain.
+    for (auto it = prefetched_.begin(); it != prefetched_.end();)
+    {
+        if (tx_after_fork(it->second.second, fork_index_))
+            it = prefetched_.erase(it);
+        else
+            ++it;
+    }
+}
+
 bool validate_block_impl::fetch_transaction(chain::transaction& tx,
         size_t& tx_height, const hash_digest& tx_hash) const
 {
+    const auto prefetched = prefetched_.find(tx_hash);
+    if (prefetched != prefetched_.end())
+    {
+        // TRANSACTION COPY
+        tx = prefetched->second.first;
+        tx_height = static_cast<size_t>(prefetched->second.second);
+        return true;
+    }
+
     uint64_t out_height;
     const auto result = chain_.get_transaction(tx, out_height, tx_hash);
 
@@ -53,7 +53,8 @@ validate_transaction::validate_transaction(block_chain& chain,
       pool_(nullptr),
       dispatch_(nullptr),
       validate_block_(&validate_block),
-      tx_hash_(tx.hash())
+      tx_hash_(tx.hash()),
+      current_input_(0)
 {
 }
 
@@ -64,7 +65,8 @@ validate_transaction::validate_transaction(block_chain& chain,
       pool_(&pool),
       dispatch_(&dispatch),
       validate_block_(nullptr),
-      tx_hash_(tx.hash())
+      tx_hash_(tx.hash()),
+      current_input_(0)
 {
 }
 
@@ -90,7 +92,7 @@ void validate_transaction::start(validate_handler handler)
     ///////////////////////////////////////////////////////////////////////////
     // Check for duplicates in the blockchain.
     blockchain_.fetch_transaction(tx_hash_,
-                                  dispatch_->unordered_delegate(
+                                  dispatch_->concurrent_delegate(
                                       &validate_transaction::handle_duplicate_check,
                                       shared_from_this(), _1));
 }
@@ -145,7 +147,7 @@ void validate_transaction::handle_duplicate_check(
 
     // Check inputs, we already know it is not a coinbase tx.
     blockchain_.fetch_last_height(
-        dispatch_->unordered_delegate(&validate_transaction::set_last_height,
+        dispatch_->concurrent_delegate(&validate_transaction::set_last_height,
                                      shared_from_this(), _1, _2));
 }
 
@@ -185,7 +187,7 @@ void validate_transaction::next_previous_transaction()
     // Needed for checking the coinbase maturity.
     blockchain_.fetch_transaction_index(
         tx_->inputs[current_input_].previous_output.hash,
-        dispatch_->unordered_delegate(
+        dispatch_->concurrent_delegate(
             &validate_transaction::previous_tx_index,
             shared_from_this(), _1, _2));
 }
@@ -204,7 +206,7 @@ void validate_transaction::previous_tx_index(const code& ec,
 
     // Now fetch actual transaction body
     blockchain_.fetch_transaction(prev_tx_hash,
-                                  dispatch_->unordered_delegate(&validate_transaction::handle_previous_tx,
+                                  dispatch_->concurrent_delegate(&validate_transaction::handle_previous_tx,
                                           shared_from_this(), _1, _2, parent_height));
 }
 
@@ -280,7 +282,7 @@ void validate_transaction::handle_previous_tx(const code& ec,
 
     // Search for double spends...
     blockchain_.fetch_spend(tx_->inputs[current_input_].previous_output,
-                            dispatch_->unordered_delegate(&validate_transaction::check_double_spend,
+                            dispatch_->concurrent_delegate(&validate_transaction::check_double_spend,
                                     shared_from_this(), _1, _2));
 }
 
@@ -140,8 +140,11 @@ uint64_t HeaderAux::dataSize(uint64_t _blockNumber)
 
 u256 HeaderAux::calculateDifficulty(libbitcoin::chain::header& _bi, libbitcoin::chain::header& _parent)
 {
-    auto minimumDifficulty = is_testnet ? bigint(10) : bigint(10);//is_testnet ? bigint(300000) : bigint(914572800);
-    bigint target;
+    // Computed in fixed width u256, which wraps on overflow exactly as the
+    // u256 sum did before it was widened to bigint. This is consensus.
+    auto minimumDifficulty = is_testnet ? u256(10) : u256(10);//is_testnet ? u256(300000) : u256(914572800);
+    u256 const& parentBits = _parent.bits;
+    u256 target;
 
     // DO NOT MODIFY time_config in release
     static uint32_t time_config{24};
@@ -152,14 +155,12 @@ u256 HeaderAux::calculateDifficulty(libbitcoin::chain::header& _bi, libbitcoin::
 
     if(_bi.timestamp >= _parent.timestamp + time_config)
     {
-        target = _parent.bits - (_parent.bits/1024);
+        target = parentBits - (parentBits / 1024);
     } else {
-        target = _parent.bits + (_parent.bits/1024);
+        target = parentBits + (parentBits / 1024);
     }
-    bigint result = target;
 
-    result = std::max<bigint>(minimumDifficulty, result);
-    return u256(std::min<bigint>(result, std::numeric_limits<u256>::max()));
+    return std::max<u256>(minimumDifficulty, target);
 }
 
 
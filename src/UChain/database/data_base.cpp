@@ -48,6 +48,9 @@ static const config::checkpoint exception1 =
 static const config::checkpoint exception2 =
 { "00000000000743f190a18c5577a3c2d2a1f610ae9601ac046a38084ccb7cd721", 91880 };
 
+// The unit of the configured map reservation.
+static constexpr size_t gigabyte = 1024 * 1024 * 1024;
+
 bool data_base::touch_file(const path& file_path)
 {
     bc::ofstream file(file_path.string());
@@ -195,6 +198,160 @@ bool data_base::upgrade_version_63(const path& prefix)
     return true;
 }
 
+// Version 2 stores an output offset table with each transaction record, which
+// a version 1 build would read as transaction bytes.
+bool data_base::upgrade_version_2(const settings& settings)
+{
+    static const std::string previous_version = "0.0.1";
+
+    // A rebuilt table that was not yet swapped in completes the upgrade.
+    const store paths(settings.directory);
+    if (boost::filesystem::exists(upgraded_path(paths)))
+    {
+        log::info(LOG_DATABASE)
+            << "Completing an interrupted upgrade of the transaction table.";
+        return replace_transactions(settings);
+    }
+
+    auto metadata_path = settings.directory / db_metadata::file_name;
+    if (!boost::filesystem::exists(metadata_path))
+        return true; // no version before, the store is opened as it is.
+
+    data_base::db_metadata metadata;
+    data_base::read_metadata(metadata_path, metadata);
+    if (metadata.version_ != previous_version)
+    {
+        if (!metadata.version_.empty() &&
+            metadata.version_ != db_metadata::current_version)
+            log::warning(LOG_DATABASE)
+                << "Database version " << metadata.version_
+                << " is not known, it is not upgraded.";
+
+        return true;
+    }
+
+    log::info(LOG_DATABASE)
+        << "Upgrading database from version " << previous_version << " to "
+        << db_metadata::current_version << ", this may take a while.";
+
+    if (!upgrade_transactions(settings)) {
+        log::error(LOG_DATABASE)
+            << "Failed to upgrade transaction database.";
+        return false;
+    }
+
+    return replace_transactions(settings);
+}
+
+data_base::path data_base::upgraded_path(const store& paths)
+{
+    return paths.transactions_lookup.string() + ".upgraded";
+}
+
+// Records are rewritten into a new table in height order. The table is only
+// renamed to the upgraded path once complete, which commits the upgrade, so
+// an interruption before that leaves the original in use and intact.
+bool data_base::upgrade_transactions(const settings& settings)
+{
+    const store paths(settings.directory);
+    const path upgraded_table = paths.transactions_lookup.string() +
+        ".upgrade";
+
+    if (boost::filesystem::exists(paths.database_lock))
+    {
+        log::error(LOG_DATABASE)
+            << "Database in " << settings.directory
+            << " is in use or was not closed cleanly.";
+        return false;
+    }
+
+    // This truncates any table left by an interrupted upgrade.
+    if (!touch_file(upgraded_table))
+        return false;
+
+    data_base instance(settings);
+    if (!instance.start())
+        return false;
+
+    transaction_database upgraded(upgraded_table);
+    size_t top;
+    auto result = instance.blocks.top(top) && upgraded.create();
+
+    for (size_t height = 0; result && height <= top; ++height)
+    {
+        // Heights above a gap in an imported chain have no block yet.
+        const auto block = instance.blocks.get(height);
+        if (!block)
+            continue;
+
+        const auto count = block.transaction_count();
+        for (size_t index = 0; result && index < count; ++index)
+        {
+            const auto tx = instance.transactions.get(
+                block.transaction_hash(index));
+            result = tx;
+
+            if (result)
+                upgraded.store(height, index, tx.transaction());
+        }
+
+        if (height % 10000 == 0)
+            log::info(LOG_DATABASE)
+                << "Upgraded transactions to height " << height << " of "
+                << top;
+    }
+
+    if (result)
+        upgraded.sync();
+
+    // Both tables are unmapped before the original is replaced.
+    result = upgraded.close() && instance.stop() && instance.close() &&
+        result;
+    if (!result)
+    {
+        log::error(LOG_DATABASE)
+            << "Failed to upgrade transaction table.";
+        boost::filesystem::remove(upgraded_table);
+        return false;
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(upgraded_table, upgraded_path(paths), ec);
+    if (ec)
+    {
+        log::error(LOG_DATABASE)
+            << "Failed to commit transaction table: " << ec.message();
+        boost::filesystem::remove(upgraded_table);
+        return false;
+    }
+
+    return true;
+}
+
+// The metadata is written before the swap, as the upgraded table is kept
+// until it has been renamed over the original, so each step may be repeated.
+bool data_base::replace_transactions(const settings& settings)
+{
+    const store paths(settings.directory);
+    auto metadata_path = settings.directory / db_metadata::file_name;
+    auto metadata = db_metadata(db_metadata::current_version);
+    data_base::write_metadata(metadata_path, metadata);
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(upgraded_path(paths), paths.transactions_lookup,
+        ec);
+    if (ec)
+    {
+        log::error(LOG_DATABASE)
+            << "Failed to replace transaction table: " << ec.message();
+        return false;
+    }
+
+    log::info(LOG_DATABASE)
+        << "Upgrading transaction table is complete.";
+    return true;
+}
+
 void data_base::set_admin(const std::string& name, const std::string& passwd)
 {
     accounts.set_admin(name, passwd);
@@ -510,30 +667,31 @@ void data_base::uninitialize_lock(const path& lock)
     boost::filesystem::remove(lock);
 }
 
+// The address space reservation applies to the growing chain tables only.
 data_base::data_base(const settings& settings)
   : data_base(settings.directory, settings.history_start_height,
-        settings.stealth_start_height)
+        settings.stealth_start_height, settings.map_reservation * gigabyte)
 {
 }
 
 data_base::data_base(const path& prefix, size_t history_height,
-    size_t stealth_height)
-  : data_base(store(prefix), history_height, stealth_height)
+    size_t stealth_height, size_t reservation)
+  : data_base(store(prefix), history_height, stealth_height, reservation)
 {
 }
 
 data_base::data_base(const store& paths, size_t history_height,
-    size_t stealth_height)
+    size_t stealth_height, size_t reservation)
   : lock_file_path_(paths.database_lock),
     history_height_(history_height),
     stealth_height_(stealth_height),
     sequential_lock_(0),
     mutex_(std::make_shared<shared_mutex>()),
-    blocks(paths.blocks_lookup, paths.blocks_index, mutex_),
-    history(paths.history_lookup, paths.history_rows, mutex_),
-    stealth(paths.stealth_rows, mutex_),
-    spends(paths.spends_lookup, mutex_),
-    transactions(paths.transactions_lookup, mutex_),
+    blocks(paths.blocks_lookup, paths.blocks_index, mutex_, reservation),
+    history(paths.history_lookup, paths.history_rows, mutex_, reservation),
+    stealth(paths.stealth_rows, mutex_, reservation),
+    spends(paths.spends_lookup, mutex_, reservation),
+    transactions(paths.transactions_lookup, mutex_, reservation),
     /* begin database for account, token, address_token, uid relationship */
     accounts(paths.accounts_lookup, mutex_),
     tokens(paths.tokens_lookup, mutex_),
@@ -818,6 +976,14 @@ bool data_base::end_write()
 // Query engines.
 // ----------------------------------------------------------------------------
 
+// The address token table is keyed by the hash of the encoded address. That
+// key is persisted so it is kept, but is computed in one place.
+static short_hash to_address_token_key(const payment_address& address)
+{
+    const auto encoded = address.encoded();
+    return ripemd160_hash(data_chunk(encoded.begin(), encoded.end()));
+}
+
 static size_t get_next_height(const block_database& blocks)
 {
     size_t current_height;
@@ -941,9 +1107,7 @@ void data_base::push_inputs(const hash_digest& tx_hash, size_t height,
         history.add_input(address.hash(), point, height, previous);
 
         /* begin added for token issue/transfer */
-        auto address_str = address.encoded();
-        data_chunk data(address_str.begin(), address_str.end());
-        short_hash key = ripemd160_hash(data);
+        const auto key = to_address_token_key(address);
         address_tokens.store_input(key, point, height, previous, timestamp_);
         address_tokens.sync();
         /* end added for token issue/transfer */
@@ -1085,9 +1249,7 @@ void data_base::pop_inputs(const input::list& inputs, size_t height)
         if (address) {
             history.delete_last_row(address.hash());
             // delete address token record
-            auto address_str = address.encoded();
-            data_chunk data(address_str.begin(), address_str.end());
-            short_hash hash = ripemd160_hash(data);
+            const auto hash = to_address_token_key(address);
             address_tokens.delete_last_row(hash);
         }
     }
@@ -1107,9 +1269,7 @@ void data_base::pop_outputs(const output::list& outputs, size_t height)
         if (address) {
             history.delete_last_row(address.hash());
             // delete address token record
-            auto address_str = address.encoded();
-            data_chunk data(address_str.begin(), address_str.end());
-            short_hash hash = ripemd160_hash(data);
+            const auto hash = to_address_token_key(address);
             bc::chain::output op = *output;
             // NOTICE: pop only the pushed row, at present uid and mit is
             // not stored in address_token, but stored separately
@@ -1194,11 +1354,7 @@ using namespace libbitcoin::config;
 void data_base::push_asset(const asset& attach, const payment_address& address,
     const output_point& outpoint, uint32_t output_height, uint64_t value)
 {
-    auto address_str = address.encoded();
-    log::trace(LOG_DATABASE) << "push_asset address_str=" << address_str;
-    log::trace(LOG_DATABASE) << "push_asset address hash=" << base16(address.hash());
-    data_chunk data(address_str.begin(), address_str.end());
-    short_hash hash = ripemd160_hash(data);
+    const auto hash = to_address_token_key(address);
     auto visitor = asset_visitor(this, hash, outpoint, output_height, value,
         attach.get_from_uid(), attach.get_to_uid());
     boost::apply_visitor(visitor, const_cast<asset&>(attach).get_attach());
@@ -52,12 +52,13 @@ const file_offset block_database::empty = 0;
 //  [ [    ...     ] ]
 
 block_database::block_database(const path& map_filename,
-    const path& index_filename, std::shared_ptr<shared_mutex> mutex)
-  : lookup_file_(map_filename, mutex),
+    const path& index_filename, std::shared_ptr<shared_mutex> mutex,
+    size_t reservation)
+  : lookup_file_(map_filename, mutex, reservation),
     lookup_header_(lookup_file_, number_buckets),
     lookup_manager_(lookup_file_, header_size),
     lookup_map_(lookup_header_, lookup_manager_),
-    index_file_(index_filename, mutex),
+    index_file_(index_filename, mutex, reservation),
     index_manager_(index_file_, 0, sizeof(file_offset))
 {
 }
@@ -44,12 +44,13 @@ BC_CONSTEXPR size_t value_size = 1 + 36 + 4 + 8;
 BC_CONSTEXPR size_t row_record_size = hash_table_record_size<hash_digest>(value_size);
 
 history_database::history_database(const path& lookup_filename,
-    const path& rows_filename, std::shared_ptr<shared_mutex> mutex)
-  : lookup_file_(lookup_filename, mutex),
+    const path& rows_filename, std::shared_ptr<shared_mutex> mutex,
+    size_t reservation)
+  : lookup_file_(lookup_filename, mutex, reservation),
     lookup_header_(lookup_file_, number_buckets),
     lookup_manager_(lookup_file_, header_size, record_size),
     lookup_map_(lookup_header_, lookup_manager_),
-    rows_file_(rows_filename, mutex),
+    rows_file_(rows_filename, mutex, reservation),
     rows_manager_(rows_file_, 0, row_record_size),
     rows_list_(rows_manager_),
     rows_multimap_(lookup_map_, rows_list_)
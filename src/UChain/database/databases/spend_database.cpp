@@ -42,8 +42,8 @@ BC_CONSTEXPR size_t value_size = std::tuple_size<chain::point>::value;
 BC_CONSTEXPR size_t record_size = hash_table_record_size<chain::point>(value_size);
 
 spend_database::spend_database(const path& filename,
-    std::shared_ptr<shared_mutex> mutex)
-  : lookup_file_(filename, mutex),
+    std::shared_ptr<shared_mutex> mutex, size_t reservation)
+  : lookup_file_(filename, mutex, reservation),
     lookup_header_(lookup_file_, number_buckets),
     lookup_manager_(lookup_file_, header_size, record_size),
     lookup_map_(lookup_header_, lookup_manager_)
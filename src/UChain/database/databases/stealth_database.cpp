@@ -42,8 +42,8 @@ constexpr size_t row_size = prefix_size + height_size + hash_size +
     short_hash_size + hash_size;
 
 stealth_database::stealth_database(const path& rows_filename,
-    std::shared_ptr<shared_mutex> mutex)
-  : rows_file_(rows_filename, mutex),
+    std::shared_ptr<shared_mutex> mutex, size_t reservation)
+  : rows_file_(rows_filename, mutex, reservation),
     rows_manager_(rows_file_, 0, row_size)
 {
 }
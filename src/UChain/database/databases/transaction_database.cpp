@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <UChain/bitcoin.hpp>
 #include <UChain/database/memory/memory.hpp>
@@ -38,8 +39,8 @@ BC_CONSTEXPR size_t header_size = slab_hash_table_header_size(number_buckets);
 BC_CONSTEXPR size_t initial_map_file_size = header_size + minimum_slabs_size;
 
 transaction_database::transaction_database(const path& map_filename,
-    std::shared_ptr<shared_mutex> mutex)
-  : lookup_file_(map_filename, mutex),
+    std::shared_ptr<shared_mutex> mutex, size_t reservation)
+  : lookup_file_(map_filename, mutex, reservation),
     lookup_header_(lookup_file_, number_buckets),
     lookup_manager_(lookup_file_, header_size),
     lookup_map_(lookup_header_, lookup_manager_)
@@ -107,6 +108,8 @@ transaction_result transaction_database::get(const hash_digest& hash) const
     return transaction_result(memory);
 }
 
+// The output offset table allows single outputs to be read without a full
+// transaction decode. Offsets are relative to the start of the transaction.
 void transaction_database::store(size_t height, size_t index,
     const chain::transaction& tx)
 {
@@ -115,19 +118,43 @@ void transaction_database::store(size_t height, size_t index,
     const auto tx_size = tx.serialized_size();
 
     BITCOIN_ASSERT(height <= max_uint32);
-    const auto hight32 = static_cast<size_t>(height);
+    const auto hight32 = static_cast<uint32_t>(height);
 
-    BITCOIN_ASSERT(index <= max_uint32);
-    const auto index32 = static_cast<size_t>(index);
+    BITCOIN_ASSERT(index < output_table_flag);
+    const auto index32 = static_cast<uint32_t>(index) | output_table_flag;
 
-    BITCOIN_ASSERT(tx_size <= max_size_t - 4 - 4);
-    const auto value_size = 4 + 4 + static_cast<size_t>(tx_size);
+    BITCOIN_ASSERT(tx.outputs.size() <= max_uint32);
+    const auto count32 = static_cast<uint32_t>(tx.outputs.size());
 
-    auto write = [&hight32, &index32, &tx](memory_ptr data)
+    // Outputs follow version, inputs and the output count.
+    std::vector<uint32_t> offsets;
+    offsets.reserve(count32);
+    uint64_t offset = 4 + variable_uint_size(tx.inputs.size());
+    for (const auto& input: tx.inputs)
+        offset += input.serialized_size();
+
+    offset += variable_uint_size(tx.outputs.size());
+    for (const auto& output: tx.outputs)
+    {
+        BITCOIN_ASSERT(offset <= max_uint32);
+        offsets.push_back(static_cast<uint32_t>(offset));
+        offset += output.serialized_size();
+    }
+
+    const auto table_size = 4 + 4 * static_cast<uint64_t>(count32);
+    BITCOIN_ASSERT(tx_size <= max_size_t - 4 - 4 - table_size);
+    const auto value_size = 4 + 4 + static_cast<size_t>(table_size + tx_size);
+
+    auto write = [&hight32, &index32, &count32, &offsets, &tx](memory_ptr data)
     {
         auto serial = make_serializer(REMAP_ADDRESS(data));
         serial.write_4_bytes_little_endian(hight32);
         serial.write_4_bytes_little_endian(index32);
+        serial.write_4_bytes_little_endian(count32);
+
+        for (const auto offset: offsets)
+            serial.write_4_bytes_little_endian(offset);
+
         serial.write_data(tx.to_data());
     };
     lookup_map_.store(key, write, value_size);
@@ -32,6 +32,7 @@
     #include <sys/mman.h>
     #define FILE_OPEN_PERMISSIONS S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH
 #endif
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <fcntl.h>
@@ -135,22 +136,25 @@ void memory_map::log_unmapped()
 
 // mmap documentation: tinyurl.com/hnbw8t5
 memory_map::memory_map(const path& filename)
-  : file_handle_(open_file(filename)),
+  : memory_map(filename, nullptr)
+{
+}
+
+memory_map::memory_map(const path& filename, mutex_ptr mutex,
+    size_t reservation)
+  : remap_mutex_(mutex),
+    reservation_(reservation),
+    file_handle_(open_file(filename)),
     filename_(filename),
     data_(nullptr),
     file_size_(file_size(file_handle_)),
+    mapped_size_(0),
     logical_size_(file_size_),
     closed_(true),
     stopped_(true)
 {
 }
 
-memory_map::memory_map(const path& filename, mutex_ptr mutex)
-  : memory_map(filename)
-{
-    remap_mutex_ = mutex;
-}
-
 // Database threads must be joined before close is called (or destruct).
 memory_map::~memory_map()
 {
@@ -249,7 +253,7 @@ bool memory_map::close()
 
     if (msync(data_, logical_size_, MS_SYNC) == -1)
         error_name = "msync";
-    else if (munmap(data_, file_size_) == -1)
+    else if (munmap(data_, mapped_size_) == -1)
         error_name = "munmap";
     else if (ftruncate(file_handle_, logical_size_) == -1)
         error_name = "ftruncate";
@@ -326,7 +330,11 @@ memory_ptr memory_map::reserve(size_t size, size_t expansion)
     {
         const auto target = size * expansion / EXPANSION_DENOMINATOR;
 
-        if (!truncate_mapped(target))
+        // Within the reserved address space the file grows in place.
+        const auto grown = target <= mapped_size_ ? allocate(target) :
+            truncate_mapped(target);
+
+        if (!grown)
         {
             handle_error("resize", filename_);
             throw std::runtime_error("Resize failure, disk space may be low.");
@@ -364,35 +372,79 @@ size_t memory_map::page()
 
 bool memory_map::unmap()
 {
-    const auto success = (munmap(data_, file_size_) != -1);
+    const auto success = (munmap(data_, mapped_size_) != -1);
     file_size_ = 0;
+    mapped_size_ = 0;
     data_ = nullptr;
     return success;
 }
 
+// The mapping may extend past the end of the file, up to the reservation.
+// Only the file range is ever addressed, so the excess is never touched.
+size_t memory_map::mapping_size(size_t size) const
+{
+#ifdef _WIN32
+    return size;
+#else
+    return std::max(size, reservation_);
+#endif
+}
+
 bool memory_map::map(size_t size)
 {
     if (size == 0)
         return false;
 
-    data_ = reinterpret_cast<uint8_t*>(mmap(0, size, PROT_READ | PROT_WRITE,
-        MAP_SHARED, file_handle_, 0));
+    const auto mapped = mapping_size(size);
+    auto flags = MAP_SHARED;
+
+#ifdef MAP_NORESERVE
+    // Do not commit swap for the reserved range beyond the file.
+    if (mapped > size)
+        flags |= MAP_NORESERVE;
+#endif
 
-    return validate(size);
+    data_ = reinterpret_cast<uint8_t*>(mmap(0, mapped, PROT_READ | PROT_WRITE,
+        flags, file_handle_, 0));
+
+    return validate(size, mapped);
 }
 
 bool memory_map::remap(size_t size)
 {
 #ifdef MREMAP_MAYMOVE
-    data_ = reinterpret_cast<uint8_t*>(mremap(data_, file_size_, size,
+    const auto mapped = mapping_size(size);
+    data_ = reinterpret_cast<uint8_t*>(mremap(data_, mapped_size_, mapped,
         MREMAP_MAYMOVE));
 
-    return validate(size);
+    return validate(size, mapped);
 #else
     return unmap() && map(size);
 #endif
 }
 
+// Extend the file within the existing mapping, the address does not change.
+bool memory_map::allocate(size_t size)
+{
+    log_resizing(size);
+
+#ifdef __linux__
+    // Allocate blocks up front, so that a full disk fails here and not as a
+    // fault on a later write. This runs under the remap lock, so where the
+    // file system cannot allocate the file is only truncated, as fallocate
+    // is not emulated by writing each block (as posix_fallocate would be).
+    if (fallocate(file_handle_, 0, 0, size) == -1 &&
+        (errno != EOPNOTSUPP || !truncate(size)))
+        return false;
+#else
+    if (!truncate(size))
+        return false;
+#endif
+
+    file_size_ = size;
+    return true;
+}
+
 bool memory_map::truncate(size_t size)
 {
     return ftruncate(file_handle_, size) != -1;
@@ -422,16 +474,18 @@ bool memory_map::truncate_mapped(size_t size)
     ///////////////////////////////////////////////////////////////////////////
 }
 
-bool memory_map::validate(size_t size)
+bool memory_map::validate(size_t size, size_t mapped)
 {
     if (data_ == MAP_FAILED)
     {
         file_size_ = 0;
+        mapped_size_ = 0;
         data_ = nullptr;
         return false;
     }
 
     file_size_ = size;
+    mapped_size_ = mapped;
     return true;
 }
 
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers 
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/database/memory/read_guard.hpp>
+
+#include <cstdint>
+#include <UChain/bitcoin.hpp>
+#include <UChain/database/define.hpp>
+#include <UChain/database/memory/memory_map.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+read_guard::read_guard(const memory_map& file)
+#ifdef REMAP_SAFETY
+  : mutex_(file.mutex_)
+#endif
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Begin Critical Section
+
+#ifdef REMAP_SAFETY
+    // Acquire shared lock.
+    mutex_.lock_shared();
+#endif
+
+    BITCOIN_ASSERT_MSG(file.data_ != nullptr, "Invalid pointer value.");
+
+    // Save protected pointer.
+    data_ = file.data_;
+}
+
+uint8_t* read_guard::buffer() const
+{
+    return data_;
+}
+
+read_guard::~read_guard()
+{
+#ifdef REMAP_SAFETY
+    // Release shared lock.
+    mutex_.unlock_shared();
+#endif
+
+    // End Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace database
+} // namespace libbitcoin
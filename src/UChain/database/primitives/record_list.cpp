@@ -57,8 +57,9 @@ array_index record_list::insert(array_index index)
 
 array_index record_list::next(array_index index) const
 {
-    const auto memory = manager_.get(index);
-    const auto next_address = REMAP_ADDRESS(memory);
+    // The guard must remain in scope until the end of the block.
+    const read_guard memory(manager_.file());
+    const auto next_address = manager_.get(memory, index);
     //*************************************************************************
     return from_little_endian_unsafe<array_index>(next_address);
     //*************************************************************************
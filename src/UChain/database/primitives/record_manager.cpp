@@ -150,6 +150,16 @@ const memory_ptr record_manager::get(array_index record) const
     return memory;
 }
 
+uint8_t* record_manager::get(const read_guard& memory, array_index record) const
+{
+    return memory.buffer() + header_size_ + record_to_position(record);
+}
+
+const memory_map& record_manager::file() const
+{
+    return file_;
+}
+
 // privates
 
 // Read the count value from the first 32 bits of the file after the header.
@@ -137,6 +137,17 @@ const memory_ptr slab_manager::get(file_offset position) const
     return memory;
 }
 
+uint8_t* slab_manager::get(const read_guard& memory, file_offset position) const
+{
+    BITCOIN_ASSERT_MSG(position < payload_size(), "Read past end of file.");
+    return memory.buffer() + header_size_ + position;
+}
+
+const memory_map& slab_manager::file() const
+{
+    return file_;
+}
+
 // privates
 
 // Read the size value from the first 64 bits of the file after the header.
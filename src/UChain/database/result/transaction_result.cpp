@@ -32,6 +32,9 @@ using namespace bc::chain;
 
 static constexpr size_t height_size = sizeof(uint32_t);
 static constexpr size_t index_size = sizeof(uint32_t);
+static constexpr size_t count_size = sizeof(uint32_t);
+static constexpr size_t offset_size = sizeof(uint32_t);
+static constexpr size_t version_size = sizeof(uint32_t);
 
 template <typename Iterator>
 chain::transaction deserialize_tx(const Iterator first)
@@ -63,15 +66,86 @@ size_t transaction_result::index() const
 {
     BITCOIN_ASSERT(slab_);
     const auto memory = REMAP_ADDRESS(slab_);
-    return from_little_endian_unsafe<uint32_t>(memory + height_size);
+    const auto index = from_little_endian_unsafe<uint32_t>(memory + height_size);
+    return index & ~output_table_flag;
+}
+
+bool transaction_result::has_output_table() const
+{
+    BITCOIN_ASSERT(slab_);
+    const auto memory = REMAP_ADDRESS(slab_);
+    const auto index = from_little_endian_unsafe<uint32_t>(memory + height_size);
+    return (index & output_table_flag) != 0;
+}
+
+// Records with an output table store [count:4][offset:4]... ahead of the tx.
+uint8_t* transaction_result::transaction_data(uint8_t* memory) const
+{
+    const auto table = memory + height_size + index_size;
+    if (!has_output_table())
+        return table;
+
+    const auto count = from_little_endian_unsafe<uint32_t>(table);
+    return table + count_size + count * offset_size;
 }
 
 chain::transaction transaction_result::transaction() const
 {
     BITCOIN_ASSERT(slab_);
     const auto memory = REMAP_ADDRESS(slab_);
-    return deserialize_tx(memory + height_size + index_size);
-    //// return deserialize_tx(memory + 8, size_limit_ - 8);
+    return deserialize_tx(transaction_data(memory));
+}
+
+bool transaction_result::is_coinbase() const
+{
+    BITCOIN_ASSERT(slab_);
+    const auto memory = REMAP_ADDRESS(slab_);
+    auto deserial = make_deserializer_unsafe(transaction_data(memory) +
+        version_size);
+
+    if (deserial.read_variable_uint_little_endian() != 1)
+        return false;
+
+    const auto hash = deserial.read_hash();
+    const auto index = deserial.read_4_bytes_little_endian();
+    return hash == null_hash && index == max_uint32;
 }
+
+size_t transaction_result::output_count() const
+{
+    BITCOIN_ASSERT(slab_);
+    if (!has_output_table())
+        return transaction().outputs.size();
+
+    const auto memory = REMAP_ADDRESS(slab_);
+    return from_little_endian_unsafe<uint32_t>(memory + height_size +
+        index_size);
+}
+
+chain::output transaction_result::output(size_t index) const
+{
+    BITCOIN_ASSERT(slab_);
+
+    // Records stored before the table was introduced are decoded in full.
+    if (!has_output_table())
+    {
+        const auto tx = transaction();
+        BITCOIN_ASSERT(index < tx.outputs.size());
+        return tx.outputs[index];
+    }
+
+    const auto memory = REMAP_ADDRESS(slab_);
+    const auto table = memory + height_size + index_size;
+    BITCOIN_ASSERT(index < from_little_endian_unsafe<uint32_t>(table));
+    const auto offset = from_little_endian_unsafe<uint32_t>(table +
+        count_size + index * offset_size);
+
+    chain::output out;
+    auto deserial = make_deserializer_unsafe(transaction_data(memory) +
+        offset);
+    out.from_data(deserial);
+    return out;
+}
+
 } // namespace database
 } // namespace libbitcoin
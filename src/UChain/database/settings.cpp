@@ -30,6 +30,7 @@ using namespace boost::filesystem;
 settings::settings()
   : history_start_height(0),
     stealth_start_height(0),
+    map_reservation(0),
     directory("database")
 {
 }
@@ -0,0 +1,534 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers 
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/database/snapshot.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <UChain/bitcoin.hpp>
+#include <UChain/database/data_base.hpp>
+#include <UChain/database/memory/memory_map.hpp>
+#include <UChain/database/settings.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+using namespace boost::filesystem;
+
+static const std::string manifest_heading = "uchain-snapshot 1";
+static const std::string import_extension = ".snapshot";
+static const std::string backup_extension = ".backup";
+
+const std::string snapshot::manifest_name = "snapshot.manifest";
+const uint64_t snapshot::chunk_size = 32 * 1024 * 1024;
+
+snapshot::snapshot(const settings& settings, size_t threads)
+  : settings_(settings),
+    threads_(std::max(threads, size_t(1)))
+{
+}
+
+// The files derived from the chain, excluding account (wallet) files.
+std::vector<snapshot::path> snapshot::chain_files() const
+{
+    const data_base::store paths(settings_.directory);
+    return
+    {
+        paths.blocks_lookup,
+        paths.blocks_index,
+        paths.history_lookup,
+        paths.history_rows,
+        paths.stealth_rows,
+        paths.spends_lookup,
+        paths.transactions_lookup,
+        paths.tokens_lookup,
+        paths.certs_lookup,
+        paths.address_tokens_lookup,
+        paths.address_tokens_rows,
+        paths.uids_lookup,
+        paths.address_uids_lookup,
+        paths.address_uids_rows,
+        paths.mits_lookup,
+        paths.address_cards_lookup,
+        paths.address_cards_rows,
+        paths.card_history_lookup,
+        paths.card_history_rows
+    };
+}
+
+// The process lock is removed on clean stop, so its presence indicates that
+// the database is in use or was not closed cleanly.
+bool snapshot::is_closed() const
+{
+    const data_base::store paths(settings_.directory);
+    if (!exists(paths.database_lock))
+        return true;
+
+    log::error(LOG_DATABASE)
+        << "Database in " << settings_.directory
+        << " is in use or was not closed cleanly.";
+    return false;
+}
+
+bool snapshot::read_height(size_t& out_height) const
+{
+    data_base database(settings_);
+    if (!database.start())
+        return false;
+
+    const auto result = database.blocks.top(out_height);
+    return database.stop() && result;
+}
+
+// Each file is replaced by its imported temporary. The originals are moved
+// aside first and restored if any step fails, so either all files are
+// replaced or none are.
+bool snapshot::replace_files(const std::vector<path>& files)
+{
+    boost::system::error_code ec;
+    const auto backup = [](const path& file)
+    {
+        return path(file.string() + backup_extension);
+    };
+
+    const auto imported = [](const path& file)
+    {
+        return path(file.string() + import_extension);
+    };
+
+    // Restore the first count originals, removing any imported files.
+    const auto roll_back = [&](size_t count, size_t installed)
+    {
+        boost::system::error_code ignore;
+        for (size_t index = 0; index < installed; ++index)
+            rename(files[index], imported(files[index]), ignore);
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            rename(backup(files[index]), files[index], ignore);
+            if (ignore)
+                log::error(LOG_DATABASE) << "Failed to restore "
+                    << files[index] << " from " << backup(files[index]);
+        }
+    };
+
+    for (size_t index = 0; index < files.size(); ++index)
+    {
+        rename(files[index], backup(files[index]), ec);
+        if (ec)
+        {
+            log::error(LOG_DATABASE) << "Failed to move aside "
+                << files[index];
+            roll_back(index, 0);
+            return false;
+        }
+    }
+
+    for (size_t index = 0; index < files.size(); ++index)
+    {
+        rename(imported(files[index]), files[index], ec);
+        if (ec)
+        {
+            log::error(LOG_DATABASE) << "Failed to replace " << files[index];
+            roll_back(files.size(), index);
+            return false;
+        }
+    }
+
+    for (const auto& file: files)
+    {
+        remove(backup(file), ec);
+        if (ec)
+            log::warning(LOG_DATABASE) << "Failed to remove "
+                << backup(file);
+    }
+
+    return true;
+}
+
+snapshot::path snapshot::chunk_path(const path& directory, const chunk& chunk)
+{
+    return directory / (chunk.file + "." + std::to_string(chunk.index));
+}
+
+// Export.
+// ----------------------------------------------------------------------------
+
+bool snapshot::export_to(const path& directory) const
+{
+    size_t height;
+    if (!is_closed() || !read_height(height))
+        return false;
+
+    boost::system::error_code ec;
+    create_directories(directory, ec);
+    if (ec || exists(directory / manifest_name))
+    {
+        log::error(LOG_DATABASE)
+            << "Snapshot directory " << directory << " is not usable.";
+        return false;
+    }
+
+    // The snapshot is in the format of the store, which may not be upgraded.
+    data_base::db_metadata metadata;
+    data_base::read_metadata(settings_.directory /
+        data_base::db_metadata::file_name, metadata);
+
+    manifest out;
+    out.version = metadata.version_;
+    out.height = height;
+
+    std::map<std::string, path> sources;
+    for (const auto& file: chain_files())
+    {
+        const auto name = file.filename().string();
+        const auto size = file_size(file, ec);
+        if (ec)
+        {
+            log::error(LOG_DATABASE) << "Failed to size " << file;
+            return false;
+        }
+
+        out.files.push_back(name);
+        sources[name] = file;
+
+        for (uint64_t offset = 0, index = 0; offset < size; ++index)
+        {
+            const auto bytes = std::min(chunk_size, size - offset);
+            out.chunks.push_back({ name, index, bytes, null_hash });
+            offset += bytes;
+        }
+    }
+
+    log::info(LOG_DATABASE)
+        << "Exporting " << out.chunks.size() << " chunks at height "
+        << height << " to " << directory;
+
+    // Each chunk is read, hashed and written independently.
+    std::atomic<bool> success(true);
+    threadpool pool(threads_);
+
+    for (auto& chunk: out.chunks)
+    {
+        const auto& source = sources[chunk.file];
+        const auto target = chunk_path(directory, chunk);
+        pool.service().post([&success, &chunk, source, target]()
+        {
+            data_chunk data(chunk.size);
+            std::ifstream in(source.string(), std::ios::binary);
+            in.seekg(chunk.index * chunk_size);
+            in.read(reinterpret_cast<char*>(data.data()), data.size());
+
+            std::ofstream file(target.string(),
+                std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(data.data()),
+                data.size());
+
+            if (!in || !file)
+            {
+                log::error(LOG_DATABASE) << "Failed to export " << target;
+                success = false;
+                return;
+            }
+
+            chunk.checksum = sha256_hash(data);
+        });
+    }
+
+    pool.shutdown();
+    pool.join();
+
+    // The manifest is written last, so its presence marks a whole snapshot.
+    if (!success || !write_manifest(out, directory))
+        return false;
+
+    log::info(LOG_DATABASE) << "Exported snapshot to " << directory;
+    return true;
+}
+
+// Import.
+// ----------------------------------------------------------------------------
+
+bool snapshot::import_from(const path& directory) const
+{
+    manifest in;
+    if (!is_closed() || !read_manifest(in, directory))
+        return false;
+
+    if (in.version != data_base::db_metadata::current_version)
+    {
+        log::error(LOG_DATABASE)
+            << "Snapshot database version " << in.version
+            << " does not match " << data_base::db_metadata::current_version;
+        return false;
+    }
+
+    // Only known chain files may be replaced.
+    std::map<std::string, path> targets;
+    for (const auto& file: chain_files())
+        targets[file.filename().string()] = file;
+
+    // The snapshot must replace every chain file, so that no file is left at
+    // another height.
+    std::map<std::string, uint64_t> sizes;
+    for (const auto& name: in.files)
+    {
+        if (targets.find(name) == targets.end() || sizes.count(name) != 0)
+        {
+            log::error(LOG_DATABASE) << "Snapshot file " << name
+                << " is not a chain file or is listed twice.";
+            return false;
+        }
+
+        sizes[name] = 0;
+    }
+
+    if (sizes.size() != targets.size())
+    {
+        log::error(LOG_DATABASE)
+            << "Snapshot does not include every chain file.";
+        return false;
+    }
+
+    // Chunks must be contiguous and full size, but for the last of a file.
+    for (const auto& chunk: in.chunks)
+    {
+        auto it = sizes.find(chunk.file);
+        if (it == sizes.end() || chunk.size == 0 || chunk.size > chunk_size ||
+            it->second != chunk.index * chunk_size)
+        {
+            log::error(LOG_DATABASE) << "Snapshot manifest is malformed.";
+            return false;
+        }
+
+        it->second += chunk.size;
+    }
+
+    // Each file is assembled beside its target and swapped in at the end.
+    boost::system::error_code ec;
+    for (const auto& size: sizes)
+    {
+        const auto temporary = targets[size.first].string() + import_extension;
+        std::ofstream(temporary, std::ios::binary | std::ios::trunc);
+        resize_file(temporary, size.second, ec);
+        if (ec)
+        {
+            log::error(LOG_DATABASE) << "Failed to create " << temporary;
+            return false;
+        }
+    }
+
+    log::info(LOG_DATABASE)
+        << "Verifying and importing " << in.chunks.size()
+        << " chunks at height " << in.height << " from " << directory;
+
+    // Chunks are mapped and verified in parallel, then written in place.
+    std::atomic<bool> success(true);
+    threadpool pool(threads_);
+
+    for (const auto& chunk: in.chunks)
+    {
+        const auto source = chunk_path(directory, chunk);
+        const auto target = targets[chunk.file].string() + import_extension;
+        pool.service().post([&success, &chunk, source, target]()
+        {
+            if (!success)
+                return;
+
+            memory_map map(source);
+            if (!map.start() || map.size() != chunk.size)
+            {
+                log::error(LOG_DATABASE) << "Failed to map " << source;
+                success = false;
+                return;
+            }
+
+            bool written;
+            {
+                const auto memory = map.access();
+                const auto begin = REMAP_ADDRESS(memory);
+                const data_slice data(begin, begin + chunk.size);
+
+                if (sha256_hash(data) != chunk.checksum)
+                {
+                    log::error(LOG_DATABASE) << "Checksum mismatch in "
+                        << source;
+                    success = false;
+                    return;
+                }
+
+                std::fstream file(target, std::ios::binary |
+                    std::ios::in | std::ios::out);
+                file.seekp(chunk.index * chunk_size);
+                file.write(reinterpret_cast<const char*>(begin), chunk.size);
+                written = !file.fail();
+            }
+
+            if (!written)
+            {
+                log::error(LOG_DATABASE) << "Failed to write " << target;
+                success = false;
+            }
+
+            map.close();
+        });
+    }
+
+    pool.shutdown();
+    pool.join();
+
+    std::vector<path> files;
+    for (const auto& size: sizes)
+        files.push_back(targets[size.first]);
+
+    if (!success || !replace_files(files))
+    {
+        for (const auto& file: files)
+            remove(file.string() + import_extension, ec);
+
+        return false;
+    }
+
+    // The chain files are now in the current format, whatever the store was,
+    // so an upgrade that was not completed must not be swapped in later.
+    remove(data_base::upgraded_path(data_base::store(settings_.directory)),
+        ec);
+    auto metadata = data_base::db_metadata(
+        data_base::db_metadata::current_version);
+    data_base::write_metadata(settings_.directory /
+        data_base::db_metadata::file_name, metadata);
+
+    log::info(LOG_DATABASE) << "Imported snapshot at height " << in.height;
+    return true;
+}
+
+// Manifest.
+// ----------------------------------------------------------------------------
+
+bool snapshot::write_manifest(const manifest& in, const path& directory)
+{
+    std::ostringstream text;
+    text << manifest_heading << "\n";
+    text << "version " << in.version << "\n";
+    text << "height " << in.height << "\n";
+
+    for (const auto& file: in.files)
+        text << "file " << file << "\n";
+
+    for (const auto& chunk: in.chunks)
+        text << "chunk " << chunk.file << " " << chunk.index << " "
+            << chunk.size << " " << encode_base16(chunk.checksum) << "\n";
+
+    const auto body = text.str();
+    const auto checksum = sha256_hash(data_chunk(body.begin(), body.end()));
+
+    std::ofstream file((directory / manifest_name).string(),
+        std::ios::trunc);
+    file << body << "checksum " << encode_base16(checksum) << "\n";
+    file.close();
+
+    if (file.fail())
+    {
+        log::error(LOG_DATABASE) << "Failed to write snapshot manifest.";
+        return false;
+    }
+
+    return true;
+}
+
+bool snapshot::read_manifest(manifest& out, const path& directory)
+{
+    std::ifstream file((directory / manifest_name).string());
+    std::string body;
+    std::string line;
+    hash_digest checksum = null_hash;
+    bool checked = false;
+
+    out = manifest();
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+
+        if (checked)
+            return false;
+
+        if (key == "checksum")
+        {
+            std::string hex;
+            fields >> hex;
+            checked = decode_base16(checksum, hex);
+            continue;
+        }
+
+        body += line + "\n";
+
+        if (line == manifest_heading)
+            continue;
+        else if (key == "version")
+            fields >> out.version;
+        else if (key == "height")
+            fields >> out.height;
+        else if (key == "file")
+        {
+            std::string name;
+            fields >> name;
+            out.files.push_back(name);
+        }
+        else if (key == "chunk")
+        {
+            chunk value;
+            std::string hex;
+            fields >> value.file >> value.index >> value.size >> hex;
+            if (!decode_base16(value.checksum, hex))
+                return false;
+
+            out.chunks.push_back(value);
+        }
+        else
+            break;
+
+        if (fields.fail())
+            break;
+    }
+
+    const auto expected = sha256_hash(data_chunk(body.begin(), body.end()));
+    if (!checked || checksum != expected ||
+        body.compare(0, manifest_heading.size(), manifest_heading) != 0)
+    {
+        log::error(LOG_DATABASE) << "Snapshot manifest in " << directory
+            << " is missing or corrupt.";
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace database
+} // namespace libbitcoin
@@ -130,65 +130,107 @@ console_result dispatch_command(int argc, const char* argv[],
     return command->invoke(out, err);
 }
 
-console_result dispatch_command(int argc, const char* argv[],
-    Json::Value& jv_output,
-    libbitcoin::server::server_node& node, uint8_t api_version)
+// Resolve the command or throw with the superseding name if any.
+static std::shared_ptr<command> find_command(const std::string& target)
 {
-    std::istringstream input;
-    std::ostringstream output;
-
-    const std::string target(argv[0]);
     const auto command = find(target);
 
     if (!command)
     {
+        std::ostringstream output;
         const std::string superseding(formerly(target));
         display_invalid_command(output, target, superseding);
         throw invalid_command_exception{ output.str() };
     }
-    auto& in = get_command_input(*command, input);
 
-    parser metadata(*command);
-    std::string error_message;
+    return command;
+}
 
-    if (!metadata.parse(error_message, in, argc, argv))
-    {
-        display_invalid_parameter(output, error_message);
-        throw command_params_exception{ output.str() };
-    }
+// Invoke a command whose options and arguments are already bound.
+static console_result invoke_command(command& command, bool help,
+    Json::Value& jv_output, libbitcoin::server::server_node& node,
+    uint8_t api_version)
+{
+    std::ostringstream output;
 
-    if (metadata.help())
+    if (help)
     {
-        command->write_help(output);
+        command.write_help(output);
         jv_output = output.str();
         return console_result::okay;
     }
 
-    command->set_api_version(api_version);
+    command.set_api_version(api_version);
 
-    if (command->category(ctgy_extension))
+    if (command.category(ctgy_extension))
     {
         // fixme. is_blockchain_sync has some problem.
-        // if (command->category(ctgy_online) && node.is_blockchain_sync()) {
-        if (command->category(ctgy_online) &&
+        // if (command.category(ctgy_online) && node.is_blockchain_sync()) {
+        if (command.category(ctgy_online) &&
             !node.chain_impl().chain_settings().use_testnet_rules) {
             uint64_t height{0};
             /*node.chain_impl().get_last_height(height);
-            if (!command->is_block_height_fullfilled(height)) {
+            if (!command.is_block_height_fullfilled(height)) {
                 throw block_sync_required_exception{"This command is unavailable because of the height < 610000."};
             }*/
         }
 
-        return static_cast<commands::command_extension*>(command.get())->invoke(jv_output, node);
+        return static_cast<commands::command_extension&>(command).invoke(jv_output, node);
     }
     else {
-        command->set_api_version(1); // only compatible for v1
-        auto retcode = command->invoke(output, output);
+        command.set_api_version(1); // only compatible for v1
+        auto retcode = command.invoke(output, output);
         jv_output = output.str();
         return retcode;
     }
 }
 
+console_result dispatch_command(int argc, const char* argv[],
+    Json::Value& jv_output,
+    libbitcoin::server::server_node& node, uint8_t api_version)
+{
+    std::istringstream input;
+
+    const auto command = find_command(argv[0]);
+    auto& in = get_command_input(*command, input);
+
+    parser metadata(*command);
+    std::string error_message;
+
+    if (!metadata.parse(error_message, in, argc, argv))
+    {
+        std::ostringstream output;
+        display_invalid_parameter(output, error_message);
+        throw command_params_exception{ output.str() };
+    }
+
+    return invoke_command(*command, metadata.help(), jv_output, node,
+        api_version);
+}
+
+console_result dispatch_command(const std::string& method,
+    const Json::Value& params, Json::Value& jv_output,
+    libbitcoin::server::server_node& node, uint8_t api_version)
+{
+    std::istringstream input;
+
+    const auto command = find_command(method);
+    auto& in = get_command_input(*command, input);
+
+    parser metadata(*command);
+    std::string error_message;
+
+    if (!metadata.parse(error_message, in, params))
+    {
+        std::ostringstream output;
+        display_invalid_parameter(output, error_message);
+        throw command_params_exception{ output.str() };
+    }
+
+    return invoke_command(*command, metadata.help(), jv_output, node,
+        api_version);
+}
+
 
 } // namespace explorer
 } // namespace libbitcoin
@@ -22,6 +22,7 @@
 #include <UChain/explorer/json_helper.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <UChain/client.hpp>
 #include <UChain/explorer/config/script.hpp>
 
@@ -1011,6 +1012,77 @@ Json::Value json_helper::prop_tree(const block& block, bool json, bool tx_json)
     return tree;
 }
 
+void json_helper::write(std::ostream& output, const Json::Value& value)
+{
+    // Writers are not thread safe, keep a compact one per thread.
+    static thread_local std::unique_ptr<Json::StreamWriter> writer([]()
+    {
+        Json::StreamWriterBuilder builder;
+        builder["indentation"] = "";
+        return builder.newStreamWriter();
+    }());
+
+    writer->write(value, &output);
+}
+
+void json_helper::write(std::ostream& output, const block& block, bool json,
+    bool tx_json)
+{
+    if (!json) {
+        write(output, prop_tree(block, false, false));
+        return;
+    }
+
+    const auto write_transactions = [&]() {
+        output << "[";
+        for (size_t index = 0; index < block.transactions.size(); ++index) {
+            if (index != 0)
+                output << ",";
+            write(output, prop_list(transaction(block.transactions[index]),
+                tx_json));
+        }
+        output << "]";
+    };
+
+    const auto header = prop_tree(block.header);
+
+    if (version_ <= 2) {
+        output << "{\"header\":";
+        write(output, header);
+        output << ",\"txs\":{\"transactions\":";
+        write_transactions();
+        output << "}}";
+        return;
+    }
+
+    // Members are emitted in the same sorted order as Json::Value uses.
+    static const std::string transactions_key("transactions");
+    auto pending = true;
+    auto separator = "{";
+
+    for (const auto& name : header.getMemberNames()) {
+        if (pending && transactions_key < name) {
+            output << separator << "\"" << transactions_key << "\":";
+            write_transactions();
+            separator = ",";
+            pending = false;
+        }
+
+        output << separator;
+        write(output, Json::Value(name));
+        output << ":";
+        write(output, header[name]);
+        separator = ",";
+    }
+
+    if (pending) {
+        output << separator << "\"" << transactions_key << "\":";
+        write_transactions();
+    }
+
+    output << "}";
+}
+
 Json::Value json_helper::prop_list(const account_info& acc)
 {
     Json::Value tree;
@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <UChain/explorer/command.hpp>
 #include <UChain/explorer/define.hpp>
@@ -79,15 +80,115 @@ void parser::load_command_variables(variables_map& variables,
         instance_.load_fallbacks(input, variables);
 }
 
+void parser::load_command_variables(variables_map& variables,
+    std::istream& input, const Json::Value& params)
+{
+    const auto options = load_options();
+    const auto arguments = load_arguments();
+
+    parsed_options parsed(&options);
+    std::vector<std::string> positional;
+
+    const auto add_option = [&](const std::string& key,
+        const Json::Value* value)
+    {
+        // Allow unambiguous abbreviations, as the command line style does.
+        const auto description = options.find_nothrow(key, true);
+        if (!description)
+            throw unknown_option("--" + key);
+
+        option item;
+        item.string_key = description->long_name();
+        item.original_tokens.push_back("--" + key);
+
+        if (value != nullptr)
+        {
+            // A switch does not consume the token that follows it.
+            if (description->semantic()->max_tokens() == 0)
+                positional.push_back(value->asString());
+            else
+                item.value.push_back(value->asString());
+
+            item.original_tokens.push_back(value->asString());
+        }
+
+        parsed.options.push_back(std::move(item));
+    };
+
+    for (const auto& param: params)
+    {
+        if (!param.isObject())
+            continue;
+
+        for (const auto& key: param.getMemberNames())
+        {
+            const auto& value = param[key];
+
+            if (value.empty())
+                add_option(key, nullptr);
+            else if (!value.isArray())
+                add_option(key, &value);
+            else
+                for (const auto& member: value)
+                    add_option(key, &member);
+        }
+
+        // Only the first object carries options.
+        break;
+    }
+
+    for (const auto& param: params)
+        if (!param.isObject())
+            positional.push_back(param.asString());
+
+    for (size_t position = 0; position < positional.size(); ++position)
+    {
+        const auto& value = positional[position];
+        if (position >= arguments.max_total_count())
+            throw too_many_positional_options_error();
+
+        option item;
+        item.string_key = arguments.name_for_position(position);
+        item.position_key = static_cast<int>(position);
+        item.value.push_back(value);
+        item.original_tokens.push_back(value);
+        parsed.options.push_back(std::move(item));
+    }
+
+    store(parsed, variables);
+
+    // Don't load rest if help is specified.
+    // For variable with stdin or file fallback load the input stream.
+    if (!get_option(variables, BX_HELP_VARIABLE))
+        instance_.load_fallbacks(input, variables);
+}
+
 bool parser::parse(std::string& out_error, std::istream& input,
     int argc, const char* argv[])
+{
+    return parse(out_error, [&](variables_map& variables)
+    {
+        load_command_variables(variables, input, argc, argv);
+    });
+}
+
+bool parser::parse(std::string& out_error, std::istream& input,
+    const Json::Value& params)
+{
+    return parse(out_error, [&](variables_map& variables)
+    {
+        load_command_variables(variables, input, params);
+    });
+}
+
+bool parser::parse(std::string& out_error, command_loader load_command)
 {
     try
     {
         variables_map variables;
 
         // Must store before environment in order for commands to supercede.
-        load_command_variables(variables, input, argc, argv);
+        load_command(variables);
 
         // Don't load rest if help is specified.
         if (!get_option(variables, BX_HELP_VARIABLE))
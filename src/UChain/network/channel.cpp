@@ -37,6 +37,10 @@ using namespace bc::message;
 using namespace std::placeholders;
 
 // Factory for deadline timer pointer construction.
+// Remembers at least this many inventory hashes per peer (about 72KB).
+static const size_t known_inventory_capacity = 10000;
+static const double known_inventory_false_rate = 0.000001;
+
 static deadline::ptr alarm(threadpool& pool, const asio::duration& duration)
 {
     return std::make_shared<deadline>(pool, pseudo_randomize(duration));
@@ -50,11 +54,13 @@ static deadline::ptr alarm(threadpool& pool, const asio::duration& duration)
 // protocol_version to the lesser of protocol_maximum and protocol_peer.
 channel::channel(threadpool& pool, socket::ptr socket,
     const settings& settings)
-  : proxy(pool, socket, settings.identifier, settings.protocol),
+  : proxy(pool, socket, settings.identifier, settings.protocol,
+        settings.channel_send_flush_bytes, settings.channel_no_delay),
     notify_(false),
     nonce_(0),
     expiration_(alarm(pool, settings.channel_expiration())),
     inactivity_(alarm(pool, settings.channel_inactivity())),
+    known_inventory_(known_inventory_capacity, known_inventory_false_rate),
     CONSTRUCT_TRACK(channel)
 {
 }
@@ -106,6 +112,11 @@ void channel::set_protocol_start_handler(std::function<void()> handler)
     protocol_start_handler_ = std::move(handler);
 }
 
+rolling_filter& channel::known_inventory()
+{
+    return known_inventory_;
+}
+
 void channel::invoke_protocol_start_handler(const code& ec)
 {
     std::function<void()> func;
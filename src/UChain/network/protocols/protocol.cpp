@@ -66,6 +66,11 @@ uint32_t protocol::peer_start_height()
     return channel_->peer_start_height();
 }
 
+rolling_filter& protocol::known_inventory()
+{
+    return channel_->known_inventory();
+}
+
 threadpool& protocol::pool()
 {
     return pool_;
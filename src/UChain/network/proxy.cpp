@@ -84,9 +84,11 @@ using namespace message;
 using namespace std::placeholders;
 
 proxy::proxy(threadpool& pool, socket::ptr socket, uint32_t protocol_magic,
-    uint32_t protocol_version)
+    uint32_t protocol_version, uint32_t send_flush_bytes, bool no_delay)
   : protocol_magic_(protocol_magic),
     protocol_version_(protocol_version),
+    send_flush_bytes_(send_flush_bytes),
+    no_delay_(no_delay),
     authority_(socket->get_authority()),
     heading_buffer_(heading::maximum_size()),
     payload_buffer_(heading::maximum_payload_size(protocol_version_)),
@@ -96,7 +98,10 @@ proxy::proxy(threadpool& pool, socket::ptr socket, uint32_t protocol_magic,
     peer_protocol_version_(message::version::level::maximum),
     message_subscriber_(pool),
     stop_subscriber_(std::make_shared<stop_subscriber>(pool, NAME)),
-    has_sent_{true},
+    sent_messages_(0),
+    sent_writes_(0),
+    sent_bytes_(0),
+    sending_(false),
     misbehaving_{0}
 {
 }
@@ -104,6 +109,11 @@ proxy::proxy(threadpool& pool, socket::ptr socket, uint32_t protocol_magic,
 proxy::~proxy()
 {
     BITCOIN_ASSERT_MSG(stopped(), "The channel was not stopped.");
+
+    log::debug(LOG_NETWORK)
+        << "Sent " << sent_messages_.load() << " messages ("
+        << sent_bytes_.load() << " bytes) in " << sent_writes_.load()
+        << " writes to [" << authority() << "]";
 }
 
 // Properties.
@@ -127,6 +137,11 @@ void proxy::set_version(message::version::ptr value)
     peer_protocol_version_.store(value->value);
 }
 
+proxy::send_statistics proxy::send_stats() const
+{
+    return { sent_messages_.load(), sent_writes_.load(), sent_bytes_.load() };
+}
+
 // Start sequence.
 // ----------------------------------------------------------------------------
 
@@ -142,6 +157,13 @@ void proxy::start(result_handler handler)
     stop_subscriber_->start();
     message_subscriber_.start();
 
+    // Small messages are coalesced by the send queue, not by the kernel.
+    {
+        const auto socket = socket_->get_socket();
+        boost_code ignore;
+        socket->get().set_option(asio::tcp::no_delay(no_delay_), ignore);
+    }
+
     // Allow for subscription before first read, so no messages are missed.
     handler(error::success);
 
@@ -346,102 +368,102 @@ void proxy::do_send(const std::string& command, const_buffer buffer,
         << "Sending " << command << " to [" << authority() << "] ("
         << buffer.size() << " bytes)";
 
-    // Critical Section (protect socket)
+    size_t outbound_size;
+
+    // Critical Section (protect socket and outbound queue)
     ///////////////////////////////////////////////////////////////////////////
-    // The socket is locked until async_write returns.
-#define QUEUE_REQUEST
-#ifdef QUEUE_REQUEST
-    bool is_ok_to_send{false};
-    uint32_t outbound_size{0};
-    request_callback h{nullptr};
     {
-        auto pThis = shared_from_this();
-        auto f = [this, pThis, buffer, handler](){
-            if (stopped())
-            {
-                handler(error::channel_stopped);
-                return;
-            }
-            const auto socket = socket_->get_socket();
-            auto& native_socket = socket->get();
-            async_write(native_socket, buffer,
-                    std::bind(&proxy::handle_send,
-                            shared_from_this(), _1, buffer, handler));
-        };
         const auto socket = socket_->get_socket();
         outbound_size = outbound_queue_.size();
-        bool is_empty{outbound_queue_.empty()};
-        bool in_sending{!has_sent_.load()};
-        is_ok_to_send = (is_empty && !in_sending);
-        if (is_ok_to_send)
-        {
-            h = std::move(f);
-            has_sent_.store(false);
-        }
-        else{
-            outbound_queue_.push(std::move(f));
-        }
+        outbound_queue_.push_back({ buffer, handler });
+
+        // A write in progress drains the queue when it completes.
+        if (!sending_)
+            flush(socket->get());
     }
+    ///////////////////////////////////////////////////////////////////////////
 
-    if (outbound_size > 500) {
+    if (outbound_size > 500)
         stop(error::size_limits);
-        return;
-    }
+}
 
-    if (is_ok_to_send)
+// The socket lock must be held by the caller.
+void proxy::flush(asio::socket& socket)
+{
+    const auto batch = std::make_shared<send_batch>();
+    std::vector<asio::const_buffer> buffers;
+    size_t bytes = 0;
+
+    // Drain queued messages into one vectored write, up to the byte cap.
+    // The first message is always taken, however large.
+    while (!outbound_queue_.empty())
     {
-        h();
+        auto& next = outbound_queue_.front();
+        const auto size = next.buffer.size();
+
+        if (!batch->empty() && bytes + size > send_flush_bytes_)
+            break;
+
+        bytes += size;
+        buffers.push_back(*next.buffer.begin());
+        batch->push_back(std::move(next));
+        outbound_queue_.pop_front();
     }
-#else
-    const auto socket = socket_->get_socket();
 
-    // The shared buffer is kept in scope until the handler is invoked.
-    using namespace boost::asio;
-    async_write(socket->get(), buffer,
+    sending_ = true;
+    ++sent_writes_;
+
+    // The shared buffers are kept in scope by the batch until completion.
+    async_write(socket, buffers,
         std::bind(&proxy::handle_send,
-            shared_from_this(), _1, buffer, handler));
-#endif
-    // The shared buffer is kept in scope until the handler is invoked.
-    ///////////////////////////////////////////////////////////////////////////
+            shared_from_this(), _1, batch));
 }
 
-void proxy::handle_send(const boost_code& ec, const_buffer buffer,
-    result_handler handler)
+void proxy::handle_send(const boost_code& ec, send_batch_ptr batch)
 {
     const auto error = code(error::boost_to_error_code(ec));
 
+    size_t bytes = 0;
+    for (const auto& sent: *batch)
+        bytes += sent.buffer.size();
+
     if (error)
+    {
         log::trace(LOG_NETWORK)
-            << "Failure sending " << buffer.size() << " byte message to ["
-            << authority() << "] " << error.message();
-    else{
+            << "Failure sending " << batch->size() << " messages (" << bytes
+            << " bytes) to [" << authority() << "] " << error.message();
+    }
+    else
+    {
+        sent_messages_ += batch->size();
+        sent_bytes_ += bytes;
 #ifndef NDEBUG
-        traffic::instance().tx(buffer.size());
+        traffic::instance().tx(bytes);
 #endif
     }
 
-    handler(error);
-#ifdef QUEUE_REQUEST
-    if(error){
-        const auto socket = socket_->get_socket();
-        std::queue<request_callback>{}.swap(outbound_queue_);
-        return;
-    }
+    for (const auto& sent: *batch)
+        sent.handler(error);
 
-    has_sent_.store(true);
+    // Critical Section (protect socket and outbound queue)
+    ///////////////////////////////////////////////////////////////////////////
+    const auto socket = socket_->get_socket();
+
+    if (error)
+        outbound_queue_.clear();
 
-    request_callback h{nullptr};
+    if (outbound_queue_.empty())
     {
-        const auto socket = socket_->get_socket();
-        if(outbound_queue_.empty())
-            return;
-        log::trace(LOG_NETWORK) << "channel:" << reinterpret_cast<int64_t>(this) << " outbound size," << outbound_queue_.size();
-        h = std::move(outbound_queue_.front());
-        outbound_queue_.pop();
-        has_sent_.store(false);
+        sending_ = false;
+        return;
     }
-    h();
-#endif
+
+    log::trace(LOG_NETWORK)
+        << "Flushing " << outbound_queue_.size() << " queued messages to ["
+        << authority() << "]";
+
+    flush(socket->get());
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 // Stop sequence.
@@ -469,7 +491,7 @@ void proxy::stop(const code& ec)
     handle_stopping();
     {
         const auto socket = socket_->get_socket();
-        std::queue<request_callback>{}.swap(outbound_queue_);
+        outbound_queue_.clear();
     }
 
     // The socket_ is internally guarded against concurrent use.
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers 
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/network/rolling_filter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <UChain/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+static const size_t bits_per_word = 64;
+
+// Optimal bit count for n items at false positive rate p: -n ln(p) / ln(2)^2.
+static size_t bit_count(size_t capacity, double rate)
+{
+    const auto ln2 = std::log(2.0);
+    const auto bits = -std::log(rate) * std::max<size_t>(capacity, 1) /
+        (ln2 * ln2);
+    const auto words = static_cast<size_t>(std::ceil(bits / bits_per_word));
+    return std::max<size_t>(words, 1) * bits_per_word;
+}
+
+// Optimal hash count for m bits and n items: m / n ln(2).
+static size_t hash_count(size_t bits, size_t capacity)
+{
+    const auto hashes = std::round(std::log(2.0) * bits /
+        std::max<size_t>(capacity, 1));
+    return std::min<size_t>(std::max<size_t>(hashes, 1), 50);
+}
+
+// The splitmix64 finalizer, spreads the salted words over all bits.
+static uint64_t mix(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+rolling_filter::rolling_filter(size_t capacity, double false_positive_rate)
+  : capacity_(std::max<size_t>(capacity, 1)),
+    bits_(bit_count(capacity, false_positive_rate)),
+    hashes_(hash_count(bits_, capacity)),
+    salt_(pseudo_random()),
+    count_(0),
+    current_(bits_ / bits_per_word, 0),
+    previous_(bits_ / bits_per_word, 0)
+{
+}
+
+// The salt keeps peers from choosing hashes that collide in our filter.
+void rolling_filter::seed(const hash_digest& hash, uint64_t& first,
+    uint64_t& step) const
+{
+    uint64_t words[2];
+    std::memcpy(words, hash.data(), sizeof(words));
+    first = mix(words[0] ^ salt_);
+    step = mix(words[1] ^ salt_) | 1;
+}
+
+bool rolling_filter::test(const generation& bits, uint64_t first,
+    uint64_t step) const
+{
+    for (size_t index = 0; index < hashes_; ++index)
+    {
+        const auto bit = (first + index * step) % bits_;
+        const auto mask = uint64_t(1) << (bit % bits_per_word);
+        if ((bits[bit / bits_per_word] & mask) == 0)
+            return false;
+    }
+
+    return true;
+}
+
+void rolling_filter::insert(const hash_digest& hash)
+{
+    uint64_t first;
+    uint64_t step;
+    seed(hash, first, step);
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    if (count_ == capacity_)
+    {
+        previous_.swap(current_);
+        std::fill(current_.begin(), current_.end(), 0);
+        count_ = 0;
+    }
+
+    for (size_t index = 0; index < hashes_; ++index)
+    {
+        const auto bit = (first + index * step) % bits_;
+        current_[bit / bits_per_word] |= uint64_t(1) << (bit % bits_per_word);
+    }
+
+    ++count_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool rolling_filter::contains(const hash_digest& hash) const
+{
+    uint64_t first;
+    uint64_t step;
+    seed(hash, first, step);
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+    return test(current_, first, step) || test(previous_, first, step);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void rolling_filter::clear()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+    std::fill(current_.begin(), current_.end(), 0);
+    std::fill(previous_.begin(), previous_.end(), 0);
+    count_ = 0;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -41,6 +41,8 @@ settings::settings()
     channel_inactivity_minutes(10),
     channel_expiration_minutes(1440),
     channel_germination_seconds(30),
+    channel_send_flush_bytes(262144),
+    channel_no_delay(true),
     host_pool_capacity(1000),
     relay_transactions(true),
     enable_re_seeding(true),
@@ -44,7 +44,8 @@ p2p_node::p2p_node(const configuration& configuration)
   : p2p(configuration.network),
     hashes_(configuration.chain.checkpoints),
     blockchain_(thread_pool(), configuration.chain, configuration.database),
-    settings_(configuration.node)
+    settings_(configuration.node),
+    requests_(asio::seconds(settings_.transaction_timeout_seconds))
 {
 }
 
@@ -201,17 +202,20 @@ bool p2p_node::handle_reorganized(const code& ec, size_t fork_point,
 // But we establish the session in network so caller doesn't need to run.
 network::session_manual::ptr p2p_node::attach_manual_session()
 {
-    return attach<node::session_manual>(blockchain_, blockchain_.pool());
+    return attach<node::session_manual>(blockchain_, blockchain_.pool(),
+        requests_);
 }
 
 network::session_inbound::ptr p2p_node::attach_inbound_session()
 {
-    return attach<node::session_inbound>(blockchain_, blockchain_.pool());
+    return attach<node::session_inbound>(blockchain_, blockchain_.pool(),
+        requests_);
 }
 
 network::session_outbound::ptr p2p_node::attach_outbound_session()
 {
-    return attach<node::session_outbound>(blockchain_, blockchain_.pool());
+    return attach<node::session_outbound>(blockchain_, blockchain_.pool(),
+        requests_);
 }
 
 session_header_sync::ptr p2p_node::attach_header_sync_session()
@@ -230,6 +234,11 @@ session_block_sync::ptr p2p_node::attach_block_sync_session()
 
 bool p2p_node::stop()
 {
+    log::debug(LOG_NODE)
+        << "Transaction requests issued " << requests_.requested()
+        << ", suppressed " << requests_.suppressed() << ", reassigned "
+        << requests_.reassigned() << ".";
+
     // Suspend new work last so we can use work to clear subscribers.
     return p2p::stop();
 }
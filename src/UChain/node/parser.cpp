@@ -204,6 +204,16 @@ options_metadata parser::load_settings()
         value<uint32_t>(&configured.network.channel_germination_seconds),
         "The maximum time limit for obtaining seed addresses, defaults to 30."
     )
+    (
+        "network.channel_send_flush_bytes",
+        value<uint32_t>(&configured.network.channel_send_flush_bytes),
+        "The byte limit of queued messages coalesced into one write, defaults to 262144."
+    )
+    (
+        "network.channel_no_delay",
+        value<bool>(&configured.network.channel_no_delay),
+        "Disable Nagle's algorithm on peer sockets, defaults to true."
+    )
     (
         "network.host_pool_capacity",
         value<uint32_t>(&configured.network.host_pool_capacity),
@@ -276,6 +286,11 @@ options_metadata parser::load_settings()
         value<uint32_t>(&configured.database.stealth_start_height),
         "The lower limit of stealth indexing, defaults to 500000."
     )
+    (
+        "database.map_reservation",
+        value<uint32_t>(&configured.database.map_reservation),
+        "The address space in GiB reserved for each block, transaction, spend, history and stealth file so that growth does not remap, defaults to 0 (disabled)."
+    )
     (
         "database.directory",
         value<path>(&configured.database.directory),
@@ -320,6 +335,11 @@ options_metadata parser::load_settings()
         value<uint32_t>(&configured.node.download_connections),
         "The maximum number of connections for initial block download, defaults to 8."
     )
+    (
+        "node.transaction_timeout_seconds",
+        value<uint32_t>(&configured.node.transaction_timeout_seconds),
+        "The time limit for transaction receipt before asking another peer, defaults to 60."
+    )
     (
         "node.transaction_pool_refresh",
         value<bool>(&configured.node.transaction_pool_refresh),
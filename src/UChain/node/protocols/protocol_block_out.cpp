@@ -312,30 +312,77 @@ bool protocol_block_out::handle_receive_get_data(const code& ec,
         return false;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    get_data_mutex_.lock();
+    get_data_queue_.push_back(message);
+    const auto answering = get_data_queue_.size() > 1;
+    get_data_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Replies follow the order of requests, so a request waits for the one
+    // being answered, which starts the next when it completes.
+    if (!answering)
+        send_next_data(message, 0);
+
+    return true;
+}
+
+// Each item is fetched from the completion of the previous one, so replies
+// are sent in the order of the inventory.
+void protocol_block_out::send_next_data(get_data_ptr message, size_t index)
+{
+    if (stopped())
+        return;
+
+    const auto& inventories = message->inventories;
+
     // TODO: these must return message objects or be copied!
     // Ignore non-block inventory requests in this protocol.
-    for (const auto& inventory: message->inventories)
+    for (; index < inventories.size(); ++index)
     {
+        const auto& inventory = inventories[index];
+
         if (inventory.type == inventory::type_id::block)
+        {
             blockchain_.fetch_block(inventory.hash,
-                BIND3(send_block, _1, _2, inventory.hash));
-        else if (inventory.type == inventory::type_id::filtered_block)
+                BIND4(send_block, _1, _2, message, index));
+            return;
+        }
+
+        if (inventory.type == inventory::type_id::filtered_block)
+        {
             blockchain_.fetch_merkle_block(inventory.hash,
-                BIND3(send_merkle_block, _1, _2, inventory.hash));
+                BIND4(send_merkle_block, _1, _2, message, index));
+            return;
+        }
     }
 
-    return true;
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    get_data_mutex_.lock();
+    BITCOIN_ASSERT(!get_data_queue_.empty());
+    get_data_queue_.pop_front();
+    const auto next = get_data_queue_.empty() ? nullptr :
+        get_data_queue_.front();
+    get_data_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (next)
+        send_next_data(next, 0);
 }
 
 // TODO: move not_found to derived class protocol_block_out_70001.
 void protocol_block_out::send_block(const code& ec, chain::block::ptr block,
-    const hash_digest& hash)
+    get_data_ptr message, size_t index)
 {
     if (stopped() || ec == (code)error::service_stopped)
     {
         return;
     }
 
+    const auto& hash = message->inventories[index].hash;
+
     if (ec == (code)error::not_found)
     {
         log::trace(LOG_NODE)
@@ -343,6 +390,7 @@ void protocol_block_out::send_block(const code& ec, chain::block::ptr block,
 
         const not_found reply{ { inventory::type_id::block, hash } };
         SEND2(reply, handle_send, _1, reply.command);
+        send_next_data(message, index + 1);
         return;
     }
 
@@ -357,15 +405,18 @@ void protocol_block_out::send_block(const code& ec, chain::block::ptr block,
 
     // TODO: eliminate copy.
     SEND2(block_message(*block), handle_send, _1, block_message::command);
+    send_next_data(message, index + 1);
 }
 
 // TODO: move filtered_block to derived class protocol_block_out_70001.
 void protocol_block_out::send_merkle_block(const code& ec,
-    merkle_block_ptr message, const hash_digest& hash)
+    merkle_block_ptr merkle, get_data_ptr message, size_t index)
 {
     if (stopped() || ec == (code)error::service_stopped)
         return;
 
+    const auto& hash = message->inventories[index].hash;
+
     if (ec == (code)error::not_found)
     {
         log::trace(LOG_NODE)
@@ -373,6 +424,7 @@ void protocol_block_out::send_merkle_block(const code& ec,
 
         const not_found reply{ { inventory::type_id::filtered_block, hash } };
         SEND2(reply, handle_send, _1, reply.command);
+        send_next_data(message, index + 1);
         return;
     }
 
@@ -385,7 +437,8 @@ void protocol_block_out::send_merkle_block(const code& ec,
         return;
     }
 
-    SEND2(*message, handle_send, _1, message->command);
+    SEND2(*merkle, handle_send, _1, merkle->command);
+    send_next_data(message, index + 1);
 }
 
 // Subscription.
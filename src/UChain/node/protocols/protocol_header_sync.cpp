@@ -26,6 +26,7 @@
 #include <UChain/network.hpp>
 #include <UChain/node/p2p_node.hpp>
 #include <UChain/node/utility/header_queue.hpp>
+#include <UChain/node/utility/performance.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -44,16 +45,18 @@ static constexpr size_t max_header_response = 500;
 // The interval in which header download rate is measured and tested.
 static const asio::seconds expiry_interval(5);
 
+// Indicates that no range is claimed by the channel.
+static constexpr size_t no_range = max_size_t;
+
 // This class requires protocol version 31800.
 protocol_header_sync::protocol_header_sync(p2p& network,
-    channel::ptr channel, header_queue& hashes, uint32_t minimum_rate,
-    const checkpoint& last)
+    channel::ptr channel, header_queue& hashes, uint32_t minimum_rate)
   : protocol_timer(network, channel, true, NAME),
     hashes_(hashes),
     current_second_(0),
+    range_(no_range),
+    received_(0),
     minimum_rate_(minimum_rate),
-    start_size_(hashes.size()),
-    last_(last),
     CONSTRUCT_TRACK(protocol_header_sync)
 {
 }
@@ -61,15 +64,24 @@ protocol_header_sync::protocol_header_sync(p2p& network,
 // Utilities
 // ----------------------------------------------------------------------------
 
-size_t protocol_header_sync::next_height() const
+bool protocol_header_sync::claim_range()
 {
-    return hashes_.last_height() + 1;
+    size_t range;
+
+    if (!hashes_.claim(range))
+    {
+        range_.store(no_range);
+        return false;
+    }
+
+    range_.store(range);
+    return true;
 }
 
-size_t protocol_header_sync::sync_rate() const
+performance protocol_header_sync::sync_rate() const
 {
-    // We can never roll back prior to start size since it's min final height.
-    return (hashes_.size() - start_size_) / current_second_;
+    // Headers are not stored during sync, so there is no database cost.
+    return { false, received_.load(), 0, current_second_ };
 }
 
 // Start sequence.
@@ -78,6 +90,14 @@ size_t protocol_header_sync::sync_rate() const
 void protocol_header_sync::start(event_handler handler)
 {
     auto complete = synchronize(BIND2(headers_complete, _1, handler), 1, NAME);
+
+    // Other channels have claimed or completed all ranges.
+    if (!claim_range())
+    {
+        complete(error::success);
+        return;
+    }
+
     protocol_timer::start(expiry_interval, BIND2(handle_event, _1, complete));
 
     SUBSCRIBE3(headers, handle_receive, _1, _2, complete);
@@ -95,12 +115,21 @@ void protocol_header_sync::send_get_headers(event_handler complete)
     if (stopped())
         return;
 
+    hash_digest last;
+    checkpoint stop;
+
+    if (!hashes_.locate(range_.load(), last, stop))
+    {
+        complete(error::operation_failed);
+        return;
+    }
+
     const get_headers request
     {
-        { hashes_.last_hash() },
-        last_.hash()
+        { last },
+        stop.hash()
     };
-    log::trace(LOG_NODE) << "send get headers, [" << encode_hash(hashes_.last_hash()) << "], stop hash[" << encode_hash(last_.hash()) << ']';
+    log::trace(LOG_NODE) << "send get headers, [" << encode_hash(last) << "], stop hash[" << encode_hash(stop.hash()) << ']';
     SEND2(request, handle_send, _1, complete);
 }
 
@@ -133,8 +162,10 @@ bool protocol_header_sync::handle_receive(const code& ec, headers_ptr message,
         return false;
     }
 
-    // A merge failure includes automatic rollback to last trust point.
-    if (!hashes_.enqueue(message))
+    const auto range = range_.load();
+
+    // A merge failure includes automatic rollback to the range start.
+    if (!hashes_.enqueue(range, message))
     {
         log::warning(LOG_NODE)
             << "Failure merging headers from [" << authority() << "]";
@@ -142,18 +173,36 @@ bool protocol_header_sync::handle_receive(const code& ec, headers_ptr message,
         return false;
     }
 
-    const auto next = next_height();
+    received_ += message->elements.size();
 
     log::info(LOG_NODE)
-        << "Synced headers " << next - message->elements.size()
-        << "-" << (next - 1) << " from [" << authority() << "]";
-
-    // If we completed the last height the sync is complete/success.
-    if (next > last_.height())
+        << "Synced " << message->elements.size() << " headers of range "
+        << range << " from [" << authority() << "]";
+
+    // A short response ends an open range only once it reaches the height
+    // this peer advertised, so a peer cannot end the sync early. An empty
+    // response is no progress, so the peer is treated as exhausted below.
+    if (!message->elements.empty() &&
+        message->elements.size() < max_header_response)
+        hashes_.seal(range, peer_start_height());
+
+    // If we completed the range take another, the sync is complete if none.
+    if (hashes_.complete(range))
     {
-        log::trace(LOG_NODE) << "protocol header sync handle receive complete";
-        complete(error::success);
-        return false;
+        log::info(LOG_NODE)
+            << "Header sync range " << range << " complete, "
+            << hashes_.merged() << " of " << hashes_.ranges()
+            << " ranges merged.";
+
+        if (!claim_range())
+        {
+            log::trace(LOG_NODE) << "protocol header sync handle receive complete";
+            complete(error::success);
+            return false;
+        }
+
+        send_get_headers(complete);
+        return true;
     }
 
     // If we received fewer than 2000 the peer is exhausted, try another.
@@ -190,11 +239,14 @@ void protocol_header_sync::handle_event(const code& ec, event_handler complete)
     // It was a timeout, so ten more seconds have passed.
     current_second_ += expiry_interval.count();
 
-    // Drop the channel if it falls below the min sync rate averaged over all.
-    if (sync_rate() < minimum_rate_)
+    // Drop the channel if it falls below the min sync rate averaged over all,
+    // its range is released to the session for reassignment to another peer.
+    const auto rate = sync_rate().total();
+
+    if (rate < minimum_rate_)
     {
         log::trace(LOG_NODE)
-            << "Header sync rate (" << sync_rate() << "/sec) from ["
+            << "Header sync rate (" << rate << "/sec) from ["
             << authority() << "]";
         complete(error::channel_timeout);
         return;
@@ -204,6 +256,11 @@ void protocol_header_sync::handle_event(const code& ec, event_handler complete)
 void protocol_header_sync::headers_complete(const code& ec,
     event_handler handler)
 {
+    // Release the range before the session decides whether to reconnect.
+    const auto range = range_.exchange(no_range);
+
+    if (range != no_range && !hashes_.complete(range))
+        hashes_.release(range);
 
     // This is end of the header sync sequence.
     handler(ec);
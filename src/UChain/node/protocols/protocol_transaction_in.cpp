@@ -20,6 +20,7 @@
  */
 #include <UChain/node/protocols/protocol_transaction_in.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -39,10 +40,12 @@ using namespace std::placeholders;
 // TODO: derive from protocol_session_node abstract intermediate base class.
 // TODO: Pass p2p_node on construct, obtaining node configuration settings.
 protocol_transaction_in::protocol_transaction_in(p2p& network,
-    channel::ptr channel, block_chain& blockchain, transaction_pool& pool)
+    channel::ptr channel, block_chain& blockchain, transaction_pool& pool,
+    transaction_requests& requests)
   : protocol_events(network, channel, NAME),
     blockchain_(blockchain),
     pool_(pool),
+    requests_(requests),
 
     // TODO: move relay to a derived class protocol_transaction_in_70001.
     relay_from_peer_(network.network_settings().relay_transactions),
@@ -109,6 +112,10 @@ bool protocol_transaction_in::handle_receive_inventory(const code& ec,
     const auto response = std::make_shared<get_data>();
     message->reduce(response->inventories, inventory::type_id::transaction);
 
+    // The peer has these, so they are not announced back to it.
+    for (const auto& inventory: response->inventories)
+        known_inventory().insert(inventory.hash);
+
     // TODO: move relay to a derived class protocol_transaction_in_70001.
     // Prior to this level transaction relay is not configurable.
     if (!relay_from_peer_ && !response->inventories.empty())
@@ -164,11 +171,49 @@ void protocol_transaction_in::send_get_data(const code& ec,
         stop(ec);
         return;
     }
+    const std::weak_ptr<protocol_transaction_in> weak =
+        std::dynamic_pointer_cast<protocol_transaction_in>(
+            protocol::shared_from_this());
+
+    // Asked of this peer only if the request to another peer times out.
+    const auto fallback = [weak](const hash_digest& hash)
+    {
+        const auto self = weak.lock();
+        return self && self->request_transaction(hash);
+    };
+
+    // Transactions already requested from another peer are not requested.
+    auto& inventories = message->inventories;
+    const auto in_flight = [this, &fallback](const inventory_vector& inventory)
+    {
+        return !requests_.claim(inventory.hash, nonce(), fallback);
+    };
+
+    inventories.erase(std::remove_if(inventories.begin(), inventories.end(),
+        in_flight), inventories.end());
+
+    if (inventories.empty())
+        return;
+
     log::trace(LOG_NODE) << "protocol_transaction_in::send_get_data";
     // inventory->get_data[transaction]
     SEND2(*message, handle_send, _1, message->command);
 }
 
+bool protocol_transaction_in::request_transaction(const hash_digest& hash)
+{
+    if (stopped())
+        return false;
+
+    log::trace(LOG_NODE)
+        << "Requesting transaction " << encode_hash(hash) << " from ["
+        << authority() << "] after timeout.";
+
+    const get_data request{ { inventory::type_id::transaction, hash } };
+    SEND2(request, handle_send, _1, request.command);
+    return true;
+}
+
 // Receive transaction sequence.
 //-----------------------------------------------------------------------------
 
@@ -197,8 +242,12 @@ bool protocol_transaction_in::handle_receive_transaction(const code& ec,
         return false;
     }
 
+    const auto hash = message->hash();
+    requests_.complete(hash);
+    known_inventory().insert(hash);
+
     log::debug(LOG_NODE)
-        << "Potential transaction from [" << authority() << "]." << encode_hash(message->hash());
+        << "Potential transaction from [" << authority() << "]." << encode_hash(hash);
 
     pool_.store(message,
         BIND2(handle_store_confirmed, _1, _2),
@@ -270,6 +319,9 @@ bool protocol_transaction_in::handle_reorganized(const code& ec, size_t,
 
 void protocol_transaction_in::handle_stop(const code&)
 {
+    // Requests in flight to this peer pass to their fallbacks.
+    requests_.release(nonce());
+
     log::trace(LOG_NETWORK)
         << "Stopped transaction_in protocol";
     blockchain_.fired();
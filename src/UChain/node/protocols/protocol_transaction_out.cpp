@@ -167,27 +167,73 @@ bool protocol_transaction_out::handle_receive_get_data(const code& ec,
 //        return ! misbehaving(20);
 //    }
 
-    // TODO: these must return message objects or be copied!
     // Ignore non-transaction inventory requests in this protocol.
+    hash_list hashes;
     for (const auto& inv: message->inventories)
         if (inv.type == inventory::type_id::transaction)
-        {
-            auto pThis = shared_from_this();
-            pool_.fetch(inv.hash, [this, &inv, pThis](const code& ec, transaction_ptr tx){
-                auto t = tx ? *tx : chain::transaction{};
-                send_transaction(ec, t, inv.hash);
-                if(ec)
-                {
-                    blockchain_.fetch_transaction(inv.hash,
-                    BIND3(send_transaction, _1, _2, inv.hash));
-                }
-            });
-        }
+            hashes.push_back(inv.hash);
+
+    if (hashes.empty())
+        return true;
+
+    // Unconfirmed transactions are served from the pool. The remainder is
+    // read from the chain in one batch once every pool lookup has returned.
+    const auto misses = std::make_shared<hash_list>();
+    const auto mutex = std::make_shared<unique_mutex>();
+    auto complete = synchronize(BIND2(handle_pool_misses, _1, misses),
+        hashes.size(), NAME);
 
+    for (const auto& hash: hashes)
+    {
+        pool_.fetch(hash, [this, hash, misses, mutex, complete](
+            const code& ec, transaction_ptr tx) mutable
+        {
+            if (!ec && tx)
+            {
+                send_transaction(ec, *tx, hash);
+            }
+            else
+            {
+                // Critical Section
+                ///////////////////////////////////////////////////////////////
+                mutex->lock();
+                misses->push_back(hash);
+                mutex->unlock();
+                ///////////////////////////////////////////////////////////////
+            }
+
+            complete(error::success);
+        });
+    }
 
     return true;
 }
 
+void protocol_transaction_out::handle_pool_misses(const code& ec,
+    std::shared_ptr<hash_list> misses)
+{
+    if (stopped() || misses->empty())
+        return;
+
+    // The batch is read on the chain's read pool, not the channel strand.
+    auto& blockchain = static_cast<block_chain_impl&>(blockchain_);
+    blockchain.fetch_transactions(*misses,
+        BIND3(send_transactions, _1, _2, _3));
+}
+
+void protocol_transaction_out::send_transactions(const code& ec,
+    const chain::transaction::list& transactions, const hash_list& missing)
+{
+    if (stopped() || ec == (code)error::service_stopped)
+        return;
+
+    for (const auto& tx: transactions)
+        send_transaction(ec, tx, tx.hash());
+
+    for (const auto& hash: missing)
+        send_transaction(error::not_found, {}, hash);
+}
+
 void protocol_transaction_out::send_transaction(const code& ec,
     const chain::transaction& transaction, const hash_digest& hash)
 {
@@ -213,7 +259,8 @@ void protocol_transaction_out::send_transaction(const code& ec,
         return;
     }
 
-    log::trace(LOG_NODE) << "send transaction " << encode_hash(transaction.hash()) << ", to " << authority();
+    log::trace(LOG_NODE) << "send transaction " << encode_hash(hash) << ", to " << authority();
+    known_inventory().insert(hash);
 
     // TODO: eliminate copy.
     SEND2(transaction_message(transaction), handle_send, _1,
@@ -245,11 +292,15 @@ bool protocol_transaction_out::handle_floated(const code& ec,
     const uint64_t fee = 0;
 
     // Transactions are discovered and announced individually.
-    if (message->originator() != nonce() && fee >= minimum_fee_.load())
+    // The peer is not told of transactions it is known to have.
+    const auto hash = message->hash();
+    if (message->originator() != nonce() && fee >= minimum_fee_.load() &&
+        !known_inventory().contains(hash))
     {
+        known_inventory().insert(hash);
         static const auto id = inventory::type_id::transaction;
-        const inventory announcement{ { id, message->hash() } };
-        log::trace(LOG_NODE) << "handle floated send transaction hash," << encode_hash(message->hash()) ;
+        const inventory announcement{ { id, hash } };
+        log::trace(LOG_NODE) << "handle floated send transaction hash," << encode_hash(hash);
         SEND2(announcement, handle_send, _1, announcement.command);
     }
 
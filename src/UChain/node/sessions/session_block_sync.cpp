@@ -46,12 +46,12 @@ using namespace std::placeholders;
 static const asio::seconds regulator_interval(5);
 
 session_block_sync::session_block_sync(p2p& network, header_queue& hashes,
-    simple_chain& chain, const settings& settings)
+    block_chain_impl& chain, const settings& settings)
   : session_batch(network, false),
     blockchain_(chain),
     reservations_count_{0},
     settings_(settings),
-    reservations_(hashes, chain, settings),
+    reservations_(pool_, hashes, chain, settings),
     CONSTRUCT_TRACK(session_block_sync)
 {
 }
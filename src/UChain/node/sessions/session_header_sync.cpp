@@ -50,6 +50,12 @@ static constexpr float back_off_factor = 0.75f;
 // The starting minimum header download rate, exponentially backs off.
 static constexpr uint32_t headers_per_second = 10000;
 
+// The maximum number of channels syncing checkpoint ranges concurrently.
+static constexpr size_t maximum_sync_channels = 8;
+
+// The number of consecutive connection failures before giving up.
+static constexpr int maximum_sync_tries = 10;
+
 // Sort is required here but not in configuration settings.
 session_header_sync::session_header_sync(p2p& network, header_queue& hashes,
     simple_chain& blockchain, const checkpoint::list& checkpoints)
@@ -85,8 +91,13 @@ void session_header_sync::handle_started(const code& ec,
     if (!initialize(handler))
         return;
 
+    // One channel per range, each channel takes another range as it finishes.
+    const auto connect = create_connector();
+    const auto channels = std::min(hashes_.ranges(), maximum_sync_channels);
+
     // This is the end of the start sequence.
-    new_connection(create_connector(), handler);
+    for (size_t channel = 0; channel < channels; ++channel)
+        new_connection(connect, handler);
 }
 
 // Header sync sequence.
@@ -116,10 +127,10 @@ void session_header_sync::handle_connect(const code& ec, channel::ptr channel,
         if(ec.value() == error::not_satisfied)
         {
             log::debug(LOG_NETWORK) << "session header sync handle connect, not satified";
-            handler(ec);
+            finish(ec, handler);
             return;
         }
-        handle_channel_stop(ec, connect, handler);
+        retry(connect, handler);
         return;
     }
 
@@ -155,7 +166,7 @@ void session_header_sync::attach_protocols(channel::ptr channel,
 {
     attach<protocol_ping>(channel)->start();
     attach<protocol_address>(channel)->start();
-    attach<protocol_header_sync>(channel, hashes_, minimum_rate_, last_)
+    attach<protocol_header_sync>(channel, hashes_, minimum_rate_.load())
         ->start(BIND4(handle_complete, _1, channel, connect, handler));
 }
 
@@ -163,41 +174,76 @@ void session_header_sync::handle_complete(const code& ec, channel::ptr channel,
     network::connector::ptr connect, result_handler handler)
 {
     channel->stop(error::channel_stopped);
+
     if (!ec)
     {
-        synced_.store(true);
         log::debug(LOG_NODE)
-                << "header sync handle complete successfully," << ec.message() ;
-        // This is the end of the header sync sequence.
-        handler(ec);
+            << "header sync channel complete, " << hashes_.merged() << " of "
+            << hashes_.ranges() << " ranges merged.";
+
+        // Other channels are still filling ranges, the last one finishes.
+        if (hashes_.synchronized())
+            finish(ec, handler);
+
         return;
     }
 
     // Reduce the rate minimum so that we don't get hung up.
-    minimum_rate_ = static_cast<uint32_t>(minimum_rate_ * back_off_factor);
+    minimum_rate_.store(static_cast<uint32_t>(minimum_rate_.load() *
+        back_off_factor));
 
     log::debug(LOG_NODE)
         << "handle complete failed," << ec.message() ;
 
-//    // There is no failure scenario, we ignore the result code here.
-//    new_connection(connect, handler);
+    // The channel's range has been released, so give it to a new peer.
+    retry(connect, handler);
 }
 
 void session_header_sync::handle_channel_stop(const code& ec, network::connector::ptr connect, result_handler handler)
 {
+    // Reconnection is driven by completion, which follows release of range.
     log::debug(LOG_NODE)
         << "Header sync channel stopped: " << ec.message();
-    if(!synced_)
+}
+
+void session_header_sync::retry(connector::ptr connect,
+    result_handler handler)
+{
+    if (synced_ || hashes_.unclaimed() == 0)
+        return;
+
+    if (++try_count_ >= maximum_sync_tries)
     {
-        ++try_count_;
-        if (try_count_ == 10)
-        {
-            log::info(LOG_NETWORK) << "session header sync handle connect try count reach 10";
-            handler(error::network_unreachable);
-            return;
-        }
-        new_connection(connect, handler);
+        log::info(LOG_NETWORK) << "session header sync handle connect try count reach " << maximum_sync_tries;
+        finish(error::network_unreachable, handler);
+        return;
+    }
+
+    new_connection(connect, handler);
+}
+
+void session_header_sync::finish(const code& ec, result_handler handler)
+{
+    // Channels complete concurrently, but the session completes once.
+    if (synced_.exchange(true))
+        return;
+
+    log::debug(LOG_NODE)
+        << "header sync complete," << ec.message() ;
+
+    // Headers beyond the local chain are an optimization, blocks will also
+    // be obtained by inventory once running, so proceed with those merged.
+    if (ec && is_open())
+    {
+        log::info(LOG_NODE)
+            << "Header sync to the tip incomplete, " << hashes_.merged()
+            << " of " << hashes_.ranges() << " ranges merged.";
+        handler(error::success);
+        return;
     }
+
+    // This is the end of the header sync sequence.
+    handler(ec);
 }
 
 // Utility.
@@ -214,7 +260,8 @@ bool session_header_sync::initialize(result_handler handler)
     }
 
     checkpoint seed;
-    const auto ec = get_range(seed, last_);
+    header parent;
+    const auto ec = get_range(seed, last_, parent);
 
     if (ec)
     {
@@ -230,21 +277,34 @@ bool session_header_sync::initialize(result_handler handler)
         return false;
     }
 
-    // The stop is either a block or a checkpoint, so it may be downloaded.
-    const auto stop_height = last_.height();
-
     // The seed is a block that we already have, so it will not be downloaded.
     const auto first_height = seed.height() + 1;
 
-    log::info(LOG_NODE)
-        << "Getting headers " << first_height << "-" << stop_height << ".";
-
     hashes_.initialize(seed);
+    hashes_.partition(last_, parent);
+
+    // The stop is either a block, a checkpoint or the best peer header.
+    if (is_open())
+        log::info(LOG_NODE)
+            << "Getting headers " << first_height << "-tip in "
+            << hashes_.ranges() << " ranges.";
+    else
+        log::info(LOG_NODE)
+            << "Getting headers " << first_height << "-" << last_.height()
+            << " in " << hashes_.ranges() << " ranges.";
+
     return true;
 }
 
+bool session_header_sync::is_open() const
+{
+    return last_.hash() == null_hash;
+}
+
 // Get the block hashes that bracket the range to download.
-code session_header_sync::get_range(checkpoint& out_seed, checkpoint& out_stop)
+// Without a gap to fill the range is open, extending to the best peer header.
+code session_header_sync::get_range(checkpoint& out_seed, checkpoint& out_stop,
+    header& out_parent)
 {
     uint64_t last_height;
 
@@ -266,13 +326,13 @@ code session_header_sync::get_range(checkpoint& out_seed, checkpoint& out_stop)
     if (!blockchain_.get_header(first_header, first_height))
         return error::not_found;
 
-    if (!checkpoints_.empty() && checkpoints_.back().height() > last_height)
+    if (first_height == last_height)
     {
-        out_stop = checkpoints_.back();
+        out_stop = std::move(checkpoint{ null_hash, max_size_t });
     }
-    else if (first_height == last_height)
+    else if (!checkpoints_.empty() && checkpoints_.back().height() > last_height)
     {
-        out_stop = std::move(checkpoint{ first_header.hash(), first_height });
+        out_stop = checkpoints_.back();
     }
     else
     {
@@ -285,6 +345,7 @@ code session_header_sync::get_range(checkpoint& out_seed, checkpoint& out_stop)
     }
 
     out_seed = std::move(checkpoint{ first_header.hash(), first_height });
+    out_parent = std::move(first_header);
     return error::success;
 }
 
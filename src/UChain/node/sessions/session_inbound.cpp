@@ -35,10 +35,11 @@ using namespace bc::network;
 using namespace std::placeholders;
 
 session_inbound::session_inbound(p2p& network, block_chain& blockchain,
-    transaction_pool& pool)
+    transaction_pool& pool, transaction_requests& requests)
   : network::session_inbound(network),
     blockchain_(blockchain),
-    pool_(pool)
+    pool_(pool),
+    requests_(requests)
 {
     log::info(LOG_NODE)
         << "Starting inbound session.";
@@ -54,7 +55,8 @@ void session_inbound::attach_handshake_protocols(channel::ptr channel,
             auto pt_address = attach<protocol_address>(channel);
             auto pt_block_in = attach<protocol_block_in>(channel, blockchain_);
             auto pt_block_out = attach<protocol_block_out>(channel, blockchain_);
-            auto pt_tx_in = attach<protocol_transaction_in>(channel, blockchain_, pool_);
+            auto pt_tx_in = attach<protocol_transaction_in>(channel, blockchain_, pool_,
+                requests_);
             auto pt_tx_out = attach<protocol_transaction_out>(channel, blockchain_, pool_);
 
             pt_ping->do_subscribe();
@@ -35,10 +35,11 @@ using namespace bc::network;
 using namespace std::placeholders;
 
 session_manual::session_manual(p2p& network, block_chain& blockchain,
-    transaction_pool& pool)
+    transaction_pool& pool, transaction_requests& requests)
   : network::session_manual(network),
     blockchain_(blockchain),
-    pool_(pool)
+    pool_(pool),
+    requests_(requests)
 {
     log::info(LOG_NODE)
         << "Starting manual session.";
@@ -54,7 +55,8 @@ void session_manual::attach_handshake_protocols(channel::ptr channel,
             auto pt_address = attach<protocol_address>(channel)->do_subscribe();
             auto pt_block_in = attach<protocol_block_in>(channel, blockchain_)->do_subscribe();
             auto pt_block_out = attach<protocol_block_out>(channel, blockchain_)->do_subscribe();
-            auto pt_tx_in = attach<protocol_transaction_in>(channel, blockchain_, pool_)->do_subscribe();
+            auto pt_tx_in = attach<protocol_transaction_in>(channel, blockchain_, pool_,
+                requests_)->do_subscribe();
             auto pt_tx_out = attach<protocol_transaction_out>(channel, blockchain_, pool_)->do_subscribe();
             channel->set_protocol_start_handler([pt_ping, pt_address, pt_block_in, pt_block_out, pt_tx_in, pt_tx_out]() {
                 pt_ping->start();
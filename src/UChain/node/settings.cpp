@@ -27,6 +27,7 @@ namespace node {
 settings::settings()
   : block_timeout_seconds(5),
     download_connections(8),
+    transaction_timeout_seconds(60),
     transaction_pool_refresh(true)
 {
 }
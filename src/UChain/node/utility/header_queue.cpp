@@ -24,6 +24,7 @@
 #include <iterator>
 #include <memory>
 #include <UChain/blockchain.hpp>
+#include <UChain/consensus/miner/MinerAux.h>
 
 namespace libbitcoin {
 namespace node {
@@ -36,6 +37,7 @@ using namespace bc::message;
 header_queue::header_queue(const config::checkpoint::list& checkpoints)
   : height_(0),
     head_(list_.begin()),
+    merged_(0),
     checkpoints_(checkpoints)
 {
 }
@@ -113,6 +115,8 @@ void header_queue::initialize(const hash_digest& hash, size_t height)
     list_.emplace_back(hash);
     head_ = list_.begin();
     height_ = height;
+    ranges_.clear();
+    merged_ = 0;
 
     mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
@@ -257,6 +261,204 @@ bool header_queue::enqueue(headers::ptr message)
     return result;
 }
 
+// Ranges.
+//-----------------------------------------------------------------------------
+// Each range starts at a trusted hash (the seed or a checkpoint) and stops at
+// the next checkpoint, so ranges can be obtained from peers independently.
+
+void header_queue::partition(const checkpoint& stop, const header& parent)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    ranges_.clear();
+    merged_ = 0;
+
+    const auto open = (stop.hash() == null_hash);
+
+    if (is_empty() || (!open && stop.height() <= last()))
+        return;
+
+    auto start_hash = list_.back();
+    auto start_height = last();
+    auto start_parent = parent;
+
+    const auto add = [&](const checkpoint& bound, bool unbounded)
+    {
+        ranges_.push_back({ start_height, { start_hash }, bound,
+            start_parent, start_parent, unbounded, false, false });
+        start_hash = bound.hash();
+        start_height = bound.height();
+        start_parent = chain::header{};
+    };
+
+    for (const auto& check: checkpoints_)
+        if (check.height() > start_height &&
+            (open || check.height() < stop.height()))
+            add(check, false);
+
+    // The open range stops wherever the peer's best chain ends.
+    add(open ? checkpoint{ null_hash, max_size_t } : stop, open);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool header_queue::claim(size_t& out_range)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    for (size_t index = merged_; index < ranges_.size(); ++index)
+    {
+        auto& span = ranges_[index];
+
+        if (!span.claimed && !span.complete)
+        {
+            span.claimed = true;
+            out_range = index;
+            return true;
+        }
+    }
+
+    return false;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void header_queue::release(size_t range)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    if (range < ranges_.size())
+        ranges_[range].claimed = false;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool header_queue::locate(size_t range, hash_digest& out_last,
+    checkpoint& out_stop) const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    if (range >= ranges_.size() || ranges_[range].hashes.empty())
+        return false;
+
+    out_last = ranges_[range].hashes.back();
+    out_stop = ranges_[range].stop;
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool header_queue::enqueue(size_t range, headers::ptr message)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    if (range < merged_ || range >= ranges_.size())
+        return false;
+
+    auto& span = ranges_[range];
+
+    if (span.complete)
+        return true;
+
+    if (!merge(span, message->elements))
+        return false;
+
+    if (span.complete)
+        merge_ranges();
+
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool header_queue::complete(size_t range) const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    return range < merged_ ||
+        (range < ranges_.size() && ranges_[range].complete);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool header_queue::synchronized() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    return merged_ == ranges_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool header_queue::seal(size_t range, size_t height)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    if (range < merged_ || range >= ranges_.size() || !ranges_[range].open)
+        return false;
+
+    auto& span = ranges_[range];
+
+    // The start hash is at the range height, so this is the last height.
+    if (span.height + span.hashes.size() - 1 < height)
+        return false;
+
+    span.complete = true;
+    merge_ranges();
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t header_queue::trusted_height() const
+{
+    return checkpoints_.empty() ? 0 : checkpoints_.back().height();
+}
+
+size_t header_queue::unclaimed() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    size_t count = 0;
+
+    for (size_t index = merged_; index < ranges_.size(); ++index)
+        if (!ranges_[index].claimed && !ranges_[index].complete)
+            ++count;
+
+    return count;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t header_queue::ranges() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    return ranges_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t header_queue::merged() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    return merged_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 // private
 //-----------------------------------------------------------------------------
 
@@ -287,6 +489,54 @@ bool header_queue::merge(const header::list& headers)
     return true;
 }
 
+// A failure resets the range to its starting trust point.
+bool header_queue::merge(range& span, const header::list& headers)
+{
+    const auto stop_height = span.stop.height();
+    span.hashes.reserve(std::min(stop_height - span.height + 1,
+        span.hashes.size() + headers.size()));
+
+    for (const auto& header: headers)
+    {
+        const auto& new_hash = header.hash();
+        const auto next_height = span.height + span.hashes.size();
+
+        if (next_height > stop_height || !linked(header, span.hashes.back()) ||
+            !check(new_hash, next_height) ||
+            (next_height == stop_height && new_hash != span.stop.hash()) ||
+            (next_height > trusted_height() && !verify(header, span)))
+        {
+            span.hashes.resize(1);
+            span.parent = span.base;
+            return false;
+        }
+
+        span.hashes.emplace_back(new_hash);
+        span.parent = header;
+    }
+
+    span.complete = !span.open &&
+        (span.height + span.hashes.size() - 1 == stop_height);
+    return true;
+}
+
+// Ranges abut, so the first hash of each is the last hash of its predecessor.
+void header_queue::merge_ranges()
+{
+    const auto offset = std::distance(list_.begin(), head_);
+
+    while (merged_ < ranges_.size() && ranges_[merged_].complete)
+    {
+        auto& span = ranges_[merged_++];
+        BITCOIN_ASSERT(!list_.empty() && list_.back() == span.hashes.front());
+        list_.insert(list_.end(), std::next(span.hashes.begin()),
+            span.hashes.end());
+        hash_list().swap(span.hashes);
+    }
+
+    head_ = std::next(list_.begin(), offset);
+}
+
 void header_queue::rollback()
 {
     if (!checkpoints_.empty())
@@ -320,6 +570,18 @@ bool header_queue::check(const hash_digest& hash, size_t height) const
     return checkpoint::validate(hash, height, checkpoints_);
 }
 
+// The first header after a checkpoint has no parent header, it is trusted to
+// the extent of its linkage, and its block is fully validated on organize.
+bool header_queue::verify(const chain::header& header, const range& span) const
+{
+    if (span.parent.hash() != span.hashes.back())
+        return true;
+
+    auto copy = header;
+    auto parent = span.parent;
+    return MinerAux::verifySeal(copy, parent);
+}
+
 bool header_queue::linked(const chain::header& header,
     const hash_digest& hash) const
 {
@@ -318,7 +318,7 @@ void reservation::insert(const hash_digest& hash, size_t height)
     ///////////////////////////////////////////////////////////////////////////
 }
 
-void reservation::import(block::ptr block)
+void reservation::import(message::block_message::ptr block)
 {
     uint32_t height;
     const auto hash = block->header.hash();
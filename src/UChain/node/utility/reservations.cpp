@@ -40,20 +40,146 @@ using namespace bc::chain;
 // The protocol maximum size of get data block requests.
 static constexpr size_t max_block_request = 50000;
 
-reservations::reservations(header_queue& hashes, simple_chain& chain,
-    const settings& settings)
+// The maximum size of get data block requests above the last checkpoint.
+// These blocks are held until organized, so this bounds buffered blocks.
+static constexpr size_t max_block_window = 1000;
+
+reservations::reservations(threadpool& pool, header_queue& hashes,
+    block_chain_impl& chain, const settings& settings)
   : hashes_(hashes),
     blockchain_(chain),
+    dispatch_(pool, "reservations"),
+    pending_(std::make_shared<pending_blocks>()),
     max_request_(max_block_request),
     timeout_(settings.block_timeout_seconds)
 {
+    pending_->contiguous = hashes.first_height();
+    pending_->organizing = false;
     initialize(settings.download_connections);
 }
 
-bool reservations::import(block::ptr block, size_t height)
+bool reservations::import(message::block_message::ptr block, size_t height)
 {
-    // Thread safe.
-    return blockchain_.import(block, height);
+    // Checkpointed blocks are written directly, in any order (thread safe).
+    if (height <= hashes_.trusted_height())
+    {
+        const auto imported = blockchain_.import(block, height);
+
+        // This may close the last gap below the buffered blocks.
+        schedule();
+        return imported;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    pending_->mutex.lock();
+    pending_->blocks.emplace(height, block);
+    pending_->mutex.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    schedule();
+    return true;
+}
+
+// Organizing fully validates each block, so it is not run on the network
+// thread that delivered the block. Only one pass is queued or running at a
+// time, so blocks are organized in height order.
+void reservations::schedule()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    pending_->mutex.lock();
+
+    if (pending_->organizing || pending_->blocks.empty())
+    {
+        pending_->mutex.unlock();
+        return;
+    }
+
+    pending_->organizing = true;
+    pending_->mutex.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    dispatch_.concurrent(&reservations::organize, pending_,
+        std::ref(blockchain_));
+}
+
+// Blocks above the last checkpoint require full validation, so they are
+// stored through the organizer strictly in height order, once the chain is
+// contiguous to the parent (there are no gaps from checkpointed imports).
+// The pending mutex is not held while a block is stored.
+void reservations::organize(pending_ptr pending, block_chain_impl& chain)
+{
+    while (true)
+    {
+        size_t height;
+        message::block_message::ptr block;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        pending->mutex.lock();
+
+        if (!next_pending(*pending, chain, block, height))
+        {
+            pending->organizing = false;
+            pending->mutex.unlock();
+            return;
+        }
+
+        pending->mutex.unlock();
+        ///////////////////////////////////////////////////////////////////////
+
+        code result;
+        const auto handler = [&result](const code& ec, uint64_t)
+        {
+            result = ec;
+        };
+
+        // The store is synchronous, the handler is invoked before return.
+        chain.store(block, handler);
+
+        if (result && result != (code)error::duplicate)
+        {
+            // Subsequent blocks cannot connect, inventory sync will recover.
+            log::warning(LOG_NODE)
+                << "Failure organizing block #" << height << ", "
+                << result.message();
+
+            ///////////////////////////////////////////////////////////////////
+            // Critical Section
+            pending->mutex.lock();
+            pending->blocks.clear();
+            pending->organizing = false;
+            pending->mutex.unlock();
+            ///////////////////////////////////////////////////////////////////
+            return;
+        }
+    }
+}
+
+bool reservations::next_pending(pending_blocks& pending,
+    block_chain_impl& chain, message::block_message::ptr& out_block,
+    size_t& out_height)
+{
+    if (pending.blocks.empty())
+        return false;
+
+    const auto next = pending.blocks.begin();
+    uint64_t gap;
+
+    // The first gap is at the buffered height only if all below exist.
+    if (!chain.get_next_gap(gap, pending.contiguous))
+        return false;
+
+    pending.contiguous = static_cast<size_t>(gap);
+
+    if (next->first != pending.contiguous)
+        return false;
+
+    out_height = next->first;
+    out_block = next->second;
+    pending.blocks.erase(next);
+    return true;
 }
 
 // Rate methods.
@@ -173,8 +299,13 @@ void reservations::initialize(size_t size)
     mark_existing();
     table_.reserve(rows);
 
-    // Allocate no more than 50k headers per row.
-    const auto max_allocation = rows * max_request();
+    // Allocate no more than 50k headers per row, and no more than a window
+    // per row beyond the last checkpoint, as those blocks must be buffered.
+    const auto first = hashes_.first_height();
+    const auto trusted = hashes_.trusted_height();
+    const auto trusted_blocks = trusted < first ? 0 : trusted - first + 1;
+    const auto max_allocation = std::min(rows * max_request(),
+        trusted_blocks + rows * max_request(trusted + 1));
     const auto allocation = std::min(blocks, max_allocation);
 
     for (auto row = 0u; row < rows; ++row)
@@ -256,7 +387,8 @@ bool reservations::reserve(reservation::ptr minimal)
     if (!minimal->empty())
         return true;
 
-    const auto allocation = std::min(hashes_.size(), max_request());
+    const auto allocation = std::min(hashes_.size(),
+        max_request(hashes_.first_height()));
 
     size_t height;
     hash_digest hash;
@@ -279,6 +411,12 @@ size_t reservations::max_request() const
     return max_request_.load();
 }
 
+size_t reservations::max_request(size_t height) const
+{
+    return height > hashes_.trusted_height() ?
+        std::min(max_block_window, max_request()) : max_request();
+}
+
 // Exposed for test to be able to control the request size.
 void reservations::set_max_request(size_t value)
 {
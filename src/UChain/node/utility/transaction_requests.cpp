@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers 
+ * Copyright (c) 2018-2020 UChain core developers (see UC-AUTHORS)
+ *
+ * This file is part of UChain.
+ *
+ * UChain is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <UChain/node/utility/transaction_requests.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <UChain/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+// Beyond this many requests in flight new requests are not tracked.
+static const size_t maximum_requests = 50000;
+
+transaction_requests::transaction_requests(const asio::duration& timeout)
+  : timeout_(timeout),
+    requested_(0),
+    suppressed_(0),
+    reassigned_(0)
+{
+}
+
+bool transaction_requests::claim(const hash_digest& hash, uint64_t peer,
+    request_handler fallback)
+{
+    expire();
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    const auto it = entries_.find(hash);
+
+    if (it == entries_.end())
+    {
+        ++requested_;
+
+        // An overfull table stops suppressing rather than growing.
+        if (entries_.size() >= maximum_requests)
+            return true;
+
+        const auto deadline = asio::steady_clock::now() + timeout_;
+        entries_.emplace(hash, entry{ peer, deadline, {} });
+        expiries_.emplace_back(deadline, hash);
+        return true;
+    }
+
+    auto& fallbacks = it->second.fallbacks;
+    const auto is_peer = [peer](const transaction_requests::fallback& item)
+    {
+        return item.first == peer;
+    };
+
+    if (it->second.owner != peer &&
+        std::none_of(fallbacks.begin(), fallbacks.end(), is_peer))
+        fallbacks.emplace_back(peer, fallback);
+
+    ++suppressed_;
+    return false;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void transaction_requests::complete(const hash_digest& hash)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    // The expiry is left to be skipped when it comes due.
+    entries_.erase(hash);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void transaction_requests::release(uint64_t peer)
+{
+    const auto now = asio::steady_clock::now();
+    const auto is_peer = [peer](const transaction_requests::fallback& item)
+    {
+        return item.first == peer;
+    };
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    mutex_.lock();
+
+    for (auto& request: entries_)
+    {
+        auto& item = request.second;
+        item.fallbacks.erase(std::remove_if(item.fallbacks.begin(),
+            item.fallbacks.end(), is_peer), item.fallbacks.end());
+
+        // Due now, ahead of every pending expiry.
+        if (item.owner == peer)
+        {
+            item.deadline = now;
+            expiries_.emplace_front(now, request.first);
+        }
+    }
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    expire();
+}
+
+// Handlers are invoked outside of the lock. A handler whose peer is gone
+// expires its request at once, so that the next fallback is tried.
+void transaction_requests::expire()
+{
+    auto requests = collect_expired(asio::steady_clock::now());
+
+    while (!requests.empty())
+    {
+        const auto now = asio::steady_clock::now();
+        auto retry = false;
+
+        for (const auto& request: requests)
+        {
+            const auto& hash = request.first;
+            const auto& next = request.second;
+
+            if (next.second(hash))
+                continue;
+
+            // Critical Section
+            ///////////////////////////////////////////////////////////////////
+            unique_lock lock(mutex_);
+            const auto it = entries_.find(hash);
+
+            if (it != entries_.end() && it->second.owner == next.first)
+            {
+                it->second.deadline = now;
+                expiries_.emplace_front(now, hash);
+                retry = true;
+            }
+            ///////////////////////////////////////////////////////////////////
+        }
+
+        requests = retry ? collect_expired(now) : request_list{};
+    }
+}
+
+transaction_requests::request_list transaction_requests::collect_expired(
+    const asio::time_point& now)
+{
+    request_list requests;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    while (!expiries_.empty() && expiries_.front().first <= now)
+    {
+        const auto deadline = expiries_.front().first;
+        const auto hash = expiries_.front().second;
+        expiries_.pop_front();
+
+        // Skip expiries of completed or since reassigned requests.
+        const auto it = entries_.find(hash);
+        if (it == entries_.end() || it->second.deadline != deadline)
+            continue;
+
+        auto& item = it->second;
+
+        if (item.fallbacks.empty())
+        {
+            entries_.erase(it);
+            continue;
+        }
+
+        auto next = std::move(item.fallbacks.front());
+        item.fallbacks.erase(item.fallbacks.begin());
+        item.owner = next.first;
+        item.deadline = now + timeout_;
+        expiries_.emplace_back(item.deadline, hash);
+        requests.emplace_back(hash, std::move(next));
+        ++reassigned_;
+    }
+
+    return requests;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t transaction_requests::size() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+    return entries_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+uint64_t transaction_requests::requested() const
+{
+    return requested_.load();
+}
+
+uint64_t transaction_requests::suppressed() const
+{
+    return suppressed_.load();
+}
+
+uint64_t transaction_requests::reassigned() const
+{
+    return reassigned_.load();
+}
+
+} // namespace node
+} // namespace libbitcoin
@@ -28,6 +28,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <UChain/server.hpp>
@@ -153,6 +154,17 @@ bool executor::do_initchain()
 
     if (ec.value() == directory_exists)
     {
+        // Snapshots are taken and restored in the format of the store as it
+        // is, so the upgrade is left to the next start of the node.
+        const auto snapshot = !metadata_.configured.export_snapshot.empty() ||
+            !metadata_.configured.import_snapshot.empty();
+
+        // Stores of the preceding version are upgraded.
+        if (!snapshot &&
+            !data_base::upgrade_version_2(metadata_.configured.database)) {
+            throw std::runtime_error{ " upgrade database to version 2 failed!" };
+        }
+
         return false;
     }
 
@@ -161,6 +173,35 @@ bool executor::do_initchain()
     return false;
 }
 
+// Snapshots are taken and restored offline, using all cores.
+bool executor::do_export_snapshot()
+{
+    const auto& directory = metadata_.configured.export_snapshot;
+    log::info(LOG_SERVER) << format(BS_SNAPSHOT_EXPORTING) % directory;
+
+    const snapshot chain_snapshot(metadata_.configured.database,
+        std::thread::hardware_concurrency());
+
+    const auto result = chain_snapshot.export_to(directory);
+    log::info(LOG_SERVER) << (result ? BS_SNAPSHOT_COMPLETE :
+        BS_SNAPSHOT_FAILED);
+    return result;
+}
+
+bool executor::do_import_snapshot()
+{
+    const auto& directory = metadata_.configured.import_snapshot;
+    log::info(LOG_SERVER) << format(BS_SNAPSHOT_IMPORTING) % directory;
+
+    const snapshot chain_snapshot(metadata_.configured.database,
+        std::thread::hardware_concurrency());
+
+    const auto result = chain_snapshot.import_from(directory);
+    log::info(LOG_SERVER) << (result ? BS_SNAPSHOT_COMPLETE :
+        BS_SNAPSHOT_FAILED);
+    return result;
+}
+
 // Menu selection.
 // ----------------------------------------------------------------------------
 
@@ -205,6 +246,14 @@ bool executor::menu()
         {
             return result;
         }
+
+        // The chain directory is initialized first, so that account files
+        // exist alongside imported chain files.
+        if (!config.export_snapshot.empty())
+            return do_export_snapshot();
+
+        if (!config.import_snapshot.empty())
+            return do_import_snapshot();
     }
     catch(const std::exception& e){ // initialize failed
         //log::error(LOG_SERVER) << format(BS_INITCHAIN_EXISTS) % data_path;
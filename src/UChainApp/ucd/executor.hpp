@@ -53,6 +53,8 @@ private:
     void do_settings();
     void do_version();
     bool do_initchain();
+    bool do_export_snapshot();
+    bool do_import_snapshot();
     void set_admin();
     void set_blackhole_uid_block_vote();
 
@@ -92,6 +94,15 @@ private:
 #define BS_INITCHAIN_COMPLETE \
     "Completed initialization."
 
+#define BS_SNAPSHOT_EXPORTING \
+    "Please wait while exporting a snapshot to %1%..."
+#define BS_SNAPSHOT_IMPORTING \
+    "Please wait while importing the snapshot in %1%..."
+#define BS_SNAPSHOT_FAILED \
+    "Snapshot failed, see log."
+#define BS_SNAPSHOT_COMPLETE \
+    "Completed snapshot."
+
 #define BS_NODE_INTERRUPT \
     "Press CTRL-C to stop the server."
 #define BS_NODE_STARTING \
@@ -38,6 +38,22 @@ bool address_key::operator==(const address_key& other) const
         prefix_filter_ == other.prefix_filter_;
 }
 
+bool address_key::operator<(const address_key& other) const
+{
+    // Consistent with route equality, which ignores the delimiter and second
+    // address.
+    const auto& left = reply_to_;
+    const auto& right = other.reply_to_;
+
+    if (left.secure != right.secure)
+        return left.secure < right.secure;
+
+    if (left.address1 != right.address1)
+        return left.address1 < right.address1;
+
+    return prefix_filter_ < other.prefix_filter_;
+}
+
 const route& address_key::reply_to() const
 {
     return reply_to_;
@@ -34,6 +34,8 @@ configuration::configuration(bc::settings context)
 // Copy constructor.
 configuration::configuration(const configuration& other)
   : node::configuration(other),
+    export_snapshot(other.export_snapshot),
+    import_snapshot(other.import_snapshot),
     server(other.server)
 {
 }
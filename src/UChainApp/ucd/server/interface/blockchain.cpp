@@ -54,11 +54,21 @@ void blockchain::fetch_history(server_node& node, const message& request,
         << "blockchain.fetch_history(" << address.encoded()
         << ", from_height=" << from_height << ")";
 
-    node.chain().fetch_history(address, limit, from_height,
-        std::bind(send_history_result,
+    // Read on the chain read pool so the worker may pipeline requests.
+    node.chain_impl().fetch_histories({ address }, limit, from_height,
+        std::bind(&blockchain::history_fetched,
             _1, _2, request, handler));
 }
 
+void blockchain::history_fetched(const code& ec,
+    const std::vector<history_compact::list>& histories,
+    const message& request, send_handler handler)
+{
+    static const history_compact::list empty;
+    send_history_result(ec, histories.empty() ? empty : histories.front(),
+        request, handler);
+}
+
 void blockchain::fetch_transaction(server_node& node, const message& request,
     send_handler handler)
 {
@@ -73,11 +83,163 @@ void blockchain::fetch_transaction(server_node& node, const message& request,
     log::debug(LOG_SERVER)
         << "blockchain.fetch_transaction(" << encode_hash(tx_hash) << ")";
 
-    node.chain().fetch_transaction(tx_hash,
-        std::bind(chain_transaction_fetched,
+    // Read on the chain read pool so the worker may pipeline requests.
+    node.chain_impl().fetch_transactions({ tx_hash },
+        std::bind(&blockchain::transaction_fetched,
+            _1, _2, _3, request, handler));
+}
+
+void blockchain::transaction_fetched(const code& ec,
+    const transaction::list& transactions, const hash_list&,
+    const message& request, send_handler handler)
+{
+    if (!ec && transactions.empty())
+    {
+        chain_transaction_fetched(error::not_found, {}, request, handler);
+        return;
+    }
+
+    chain_transaction_fetched(ec, ec ? transaction() : transactions.front(),
+        request, handler);
+}
+
+// Batched queries.
+// ----------------------------------------------------------------------------
+
+const size_t blockchain::maximum_batch = 1000;
+
+void blockchain::fetch_histories(server_node& node, const message& request,
+    send_handler handler)
+{
+    static constexpr uint64_t limit = 0;
+    static constexpr size_t key_size = sizeof(uint8_t) + short_hash_size;
+    const auto& data = request.data();
+
+    // [ from_height:4 ][[ version:1 ][ hash:20 ]...]
+    const auto keys_size = data.size() - sizeof(uint32_t);
+    if (data.size() <= sizeof(uint32_t) || keys_size % key_size != 0 ||
+        keys_size / key_size > maximum_batch)
+    {
+        handler(message(request, error::bad_stream));
+        return;
+    }
+
+    auto deserial = make_deserializer(data.begin(), data.end());
+    const uint64_t from_height = deserial.read_4_bytes_little_endian();
+
+    std::vector<payment_address> addresses;
+    addresses.reserve(keys_size / key_size);
+
+    while (deserial.iterator() != data.end())
+    {
+        const auto version_byte = deserial.read_byte();
+        const auto hash = deserial.read_short_hash();
+        addresses.emplace_back(hash, version_byte);
+    }
+
+    log::debug(LOG_SERVER)
+        << "blockchain.fetch_histories(" << addresses.size()
+        << ", from_height=" << from_height << ")";
+
+    node.chain_impl().fetch_histories(addresses, limit, from_height,
+        std::bind(&blockchain::histories_fetched,
             _1, _2, request, handler));
 }
 
+void blockchain::histories_fetched(const code& ec,
+    const std::vector<history_compact::list>& histories,
+    const message& request, send_handler handler)
+{
+    static constexpr size_t row_size = sizeof(uint8_t) + point_size +
+        sizeof(uint32_t) + sizeof(uint64_t);
+
+    size_t rows = 0;
+    for (const auto& history: histories)
+        rows += history.size();
+
+    // [ code:4 ]
+    // [[ count:4 ][[ kind:1 ][ point:36 ][ height:4 ][ value:8 ]...]...]
+    data_chunk result(code_size + sizeof(uint32_t) * histories.size() +
+        row_size * rows);
+    auto serial = make_serializer(result.begin());
+    serial.write_error_code(ec);
+
+    for (const auto& history: histories)
+    {
+        BITCOIN_ASSERT(history.size() <= max_uint32);
+        serial.write_4_bytes_little_endian(
+            static_cast<uint32_t>(history.size()));
+
+        for (const auto& row: history)
+        {
+            BITCOIN_ASSERT(row.height <= max_uint32);
+            serial.write_byte(static_cast<uint8_t>(row.kind));
+            serial.write_data(row.point.to_data());
+            serial.write_4_bytes_little_endian(
+                static_cast<uint32_t>(row.height));
+            serial.write_8_bytes_little_endian(row.value);
+        }
+    }
+
+    BITCOIN_ASSERT(serial.iterator() == result.end());
+    handler(message(request, result));
+}
+
+void blockchain::fetch_transactions(server_node& node,
+    const message& request, send_handler handler)
+{
+    const auto& data = request.data();
+
+    // [[ hash:32 ]...]
+    if (data.empty() || data.size() % hash_size != 0 ||
+        data.size() / hash_size > maximum_batch)
+    {
+        handler(message(request, error::bad_stream));
+        return;
+    }
+
+    hash_list hashes;
+    hashes.reserve(data.size() / hash_size);
+    auto deserial = make_deserializer(data.begin(), data.end());
+
+    while (deserial.iterator() != data.end())
+        hashes.push_back(deserial.read_hash());
+
+    log::debug(LOG_SERVER)
+        << "blockchain.fetch_transactions(" << hashes.size() << ")";
+
+    node.chain_impl().fetch_transactions(hashes,
+        std::bind(&blockchain::transactions_fetched,
+            _1, _2, _3, request, handler));
+}
+
+void blockchain::transactions_fetched(const code& ec,
+    const transaction::list& transactions, const hash_list& missing,
+    const message& request, send_handler handler)
+{
+    BITCOIN_ASSERT(transactions.size() <= max_uint32);
+    BITCOIN_ASSERT(missing.size() <= max_uint32);
+
+    // [ code:4 ]
+    // [ count:4 ][[ transaction... ]...]
+    // [ missing:4 ][[ hash:32 ]...]
+    data_chunk result;
+    extend_data(result, message::to_bytes(ec));
+    extend_data(result, to_little_endian(
+        static_cast<uint32_t>(transactions.size())));
+
+    for (const auto& tx: transactions)
+        extend_data(result, tx.to_data());
+
+    extend_data(result, to_little_endian(
+        static_cast<uint32_t>(missing.size())));
+
+    for (const auto& hash: missing)
+        extend_data(result, hash);
+
+    handler(message(request, result));
+}
+
 void blockchain::fetch_last_height(server_node& node, const message& request,
     send_handler handler)
 {
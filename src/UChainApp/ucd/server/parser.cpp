@@ -75,6 +75,16 @@ options_metadata parser::load_options()
             default_value(false)->zero_tokens(),
         "Initialize blockchain in the configured directory."
     )
+    (
+        "export-snapshot",
+        value<path>(&configured.export_snapshot),
+        "Write a snapshot of the chain state to the specified directory and exit."
+    )
+    (
+        "import-snapshot",
+        value<path>(&configured.import_snapshot),
+        "Replace the chain state with the snapshot in the specified directory and exit."
+    )
     (
         BS_SETTINGS_VARIABLE ",s",
         value<bool>(&configured.settings)->
@@ -221,6 +231,16 @@ options_metadata parser::load_settings()
         value<uint32_t>(&configured.network.channel_germination_seconds),
         "The maximum time limit for obtaining seed addresses, defaults to 30."
     )
+    (
+        "network.channel_send_flush_bytes",
+        value<uint32_t>(&configured.network.channel_send_flush_bytes),
+        "The byte limit of queued messages coalesced into one write, defaults to 262144."
+    )
+    (
+        "network.channel_no_delay",
+        value<bool>(&configured.network.channel_no_delay),
+        "Disable Nagle's algorithm on peer sockets, defaults to true."
+    )
     (
         "network.host_pool_capacity",
         value<uint32_t>(&configured.network.host_pool_capacity),
@@ -293,6 +313,11 @@ options_metadata parser::load_settings()
         value<uint32_t>(&configured.database.stealth_start_height),
         "The lower limit of stealth indexing, defaults to 350000."
     )
+    (
+        "database.map_reservation",
+        value<uint32_t>(&configured.database.map_reservation),
+        "The address space in GiB reserved for each block, transaction, spend, history and stealth file so that growth does not remap, defaults to 0 (disabled)."
+    )
     (
         "database.directory",
         value<path>(&configured.database.directory),
@@ -337,6 +362,11 @@ options_metadata parser::load_settings()
         value<uint32_t>(&configured.node.download_connections),
         "The maximum number of connections for initial block download, defaults to 8."
     )
+    (
+        "node.transaction_timeout_seconds",
+        value<uint32_t>(&configured.node.transaction_timeout_seconds),
+        "The time limit for transaction receipt before asking another peer, defaults to 60."
+    )
     (
         "node.transaction_pool_refresh",
         value<bool>(&configured.node.transaction_pool_refresh),
@@ -362,7 +392,7 @@ options_metadata parser::load_settings()
     (
         "server.query_workers",
         value<uint16_t>(&configured.server.query_workers),
-        "The number of query worker threads per endpoint, defaults to 1."
+        "The number of query worker threads per endpoint, defaults to 4."
     )
     (
         "server.heartbeat_interval_seconds",
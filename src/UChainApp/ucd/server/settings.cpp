@@ -27,7 +27,7 @@ namespace server {
 using namespace asio;
 
 settings::settings()
-  : query_workers(1),
+  : query_workers(4),
     heartbeat_interval_seconds(5),
     subscription_expiration_minutes(10),
     subscription_limit(100000000),
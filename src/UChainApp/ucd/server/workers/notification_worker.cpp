@@ -25,6 +25,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 #include <UChain/protocol.hpp>
 #include <UChain/server/messages/message.hpp>
 #include <UChain/server/messages/route.hpp>
@@ -46,6 +47,10 @@ using namespace bc::wallet;
 // Purge subscriptions at 10% of the expiration period.
 static constexpr int64_t purge_interval_ratio = 10;
 
+// Payment and address keys are hash160, stealth keys are 32 bit prefixes.
+static constexpr size_t address_bits = short_hash_size * byte_bits;
+static constexpr size_t prefix_bits = sizeof(uint32_t) * byte_bits;
+
 // Notifications respond with commands that are distinct from the subscription.
 static const std::string address_update("address.update");
 static const std::string address_stealth("address.stealth_update");
@@ -66,7 +71,10 @@ notification_worker::notification_worker(zmq::authenticator& authenticator,
     address_subscriber_(std::make_shared<address_subscriber>(
         node.thread_pool(), settings_.subscription_limit, NAME "_address")),
     penetration_subscriber_(std::make_shared<penetration_subscriber>(
-        node.thread_pool(), settings_.subscription_limit, NAME "_penetration"))
+        node.thread_pool(), settings_.subscription_limit, NAME "_penetration")),
+    payment_index_(address_bits),
+    stealth_index_(prefix_bits),
+    address_index_(address_bits)
 {
 }
 
@@ -318,6 +326,7 @@ bool notification_worker::handle_payment(const code& ec,
 {
     if (ec)
     {
+        unindex_key(payment_index_, address_key(reply_to, prefix_filter));
         send(reply_to, address_update, id, message::to_bytes(ec));
         return false;
     }
@@ -335,6 +344,7 @@ bool notification_worker::handle_stealth(const code& ec,
 {
     if (ec)
     {
+        unindex_key(stealth_index_, address_key(reply_to, prefix_filter));
         send(reply_to, address_stealth, id, message::to_bytes(ec));
         return false;
     }
@@ -352,6 +362,7 @@ bool notification_worker::handle_address(const code& ec,
 {
     if (ec)
     {
+        unindex_key(address_index_, address_key(reply_to, prefix_filter));
         send(reply_to, address_update2, id, message::to_bytes(ec));
         return false;
     }
@@ -387,6 +398,7 @@ void notification_worker::subscribe_address(const route& reply_to, uint32_t id,
                 std::bind(&notification_worker::handle_payment,
                     this, _1, _2, _3, _4, _5, reply_to, id, prefix_filter);
 
+            index_key(payment_index_, key);
             payment_subscriber_->subscribe(handler, key, duration, error_code,
                 {}, 0, {}, {});
             break;
@@ -400,6 +412,7 @@ void notification_worker::subscribe_address(const route& reply_to, uint32_t id,
                 std::bind(&notification_worker::handle_stealth,
                     this, _1, _2, _3, _4, _5, reply_to, id, prefix_filter);
 
+            index_key(stealth_index_, key);
             stealth_subscriber_->subscribe(handler, key, duration, error_code,
                 0, 0, {}, {});
             break;
@@ -418,6 +431,7 @@ void notification_worker::subscribe_address(const route& reply_to, uint32_t id,
                     sequence);
 
             // v3
+            index_key(address_index_, key);
             address_subscriber_->subscribe(handler, key, duration, error_code,
                 {}, 0, {}, {});
             break;
@@ -595,10 +609,6 @@ void notification_worker::notify_transaction(uint32_t height,
 {
     uint32_t prefix;
 
-    // TODO: move full integer and array constructors into binary.
-    static constexpr size_t prefix_bits = sizeof(prefix) * byte_bits;
-    static constexpr size_t address_bits = short_hash_size * byte_bits;
-
     if (stopped() || tx.outputs.empty())
         return;
 
@@ -654,7 +664,12 @@ void notification_worker::notify_payment(const payment_address& address,
     uint32_t height, const hash_digest& block_hash, const transaction& tx)
 {
     static const auto code = error::success;
-    payment_subscriber_->relay(code, address, height, block_hash, tx);
+    std::vector<address_key> keys;
+    const binary field(address_bits, address.hash());
+
+    if (find_keys(payment_index_, field, keys))
+        payment_subscriber_->relay_to(keys, code, address, height, block_hash,
+            tx);
 }
 
 // v2/v3 (deprecated)
@@ -662,7 +677,12 @@ void notification_worker::notify_stealth(uint32_t prefix, uint32_t height,
     const hash_digest& block_hash, const transaction& tx)
 {
     static const auto code = error::success;
-    stealth_subscriber_->relay(code, prefix, height, block_hash, tx);
+    std::vector<address_key> keys;
+    const binary field(prefix_bits, to_little_endian(prefix));
+
+    if (find_keys(stealth_index_, field, keys))
+        stealth_subscriber_->relay_to(keys, code, prefix, height, block_hash,
+            tx);
 }
 
 // v3
@@ -670,7 +690,11 @@ void notification_worker::notify_address(const binary& field, uint32_t height,
     const hash_digest& block_hash, const transaction& tx)
 {
     static const auto code = error::success;
-    address_subscriber_->relay(code, field, height, block_hash, tx);
+    std::vector<address_key> keys;
+
+    if (find_keys(address_index_, field, keys))
+        address_subscriber_->relay_to(keys, code, field, height, block_hash,
+            tx);
 }
 
 // v3.x
@@ -681,5 +705,45 @@ void notification_worker::notify_penetration(uint32_t height,
     penetration_subscriber_->relay(code, height, block_hash, tx_hash);
 }
 
+// Index.
+// ----------------------------------------------------------------------------
+// The index is never locked while a subscriber is invoked, since handlers
+// unindex their own key on expiration.
+
+bool notification_worker::find_keys(const address_index& index,
+    const binary& field, std::vector<address_key>& out) const
+{
+    address_index::subscribers matches;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(index_mutex_);
+    index.find(field, matches);
+    ///////////////////////////////////////////////////////////////////////////
+
+    out.assign(matches.begin(), matches.end());
+    return !out.empty();
+}
+
+void notification_worker::index_key(address_index& index,
+    const address_key& key)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(index_mutex_);
+    index.add(key.prefix_filter(), key);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void notification_worker::unindex_key(address_index& index,
+    const address_key& key)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(index_mutex_);
+    index.remove(key.prefix_filter(), key);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 } // namespace server
 } // namespace libbitcoin
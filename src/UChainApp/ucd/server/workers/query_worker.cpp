@@ -20,7 +20,9 @@
  */
 #include <UChain/server/workers/query_worker.hpp>
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <string>
 #include <UChain/protocol.hpp>
 #include <UChain/server/define.hpp>
@@ -37,14 +39,20 @@ namespace server {
 using namespace std::placeholders;
 using namespace bc::protocol;
 
+// The poll interval while responses are pending on other threads.
+static constexpr int32_t response_poll_milliseconds = 1;
+
 query_worker::query_worker(zmq::authenticator& authenticator,
     server_node& node, bool secure)
   : worker(node.thread_pool()),
     secure_(secure),
     settings_(node.server_settings()),
     node_(node),
-    authenticator_(authenticator)
+    authenticator_(authenticator),
+    responses_(std::make_shared<response_queue>())
 {
+    responses_->outstanding = 0;
+
     // The same interface is attached to the secure and public interfaces.
     attach_interface();
 }
@@ -65,8 +73,14 @@ void query_worker::work()
 
     while (!poller.terminated() && !stopped())
     {
-        if (poller.wait().contains(router.id()))
+        // Queries are pipelined, so poll briefly while any are outstanding.
+        const auto ready = responses_->outstanding == 0 ? poller.wait() :
+            poller.wait(response_poll_milliseconds);
+
+        if (ready.contains(router.id()))
             query(router);
+
+        respond(router);
     }
 
     // Disconnect the socket and exit this thread.
@@ -114,23 +128,32 @@ bool query_worker::disconnect(zmq::socket& router)
 //-----------------------------------------------------------------------------
 
 // Because the socket is a router we may simply drop invalid queries.
-// As a single thread worker this router should not reach high water.
+// Responses are queued, so many queries may be outstanding on this worker.
 // If we implemented as a replier we would need to always provide a response.
 void query_worker::query(zmq::socket& router)
 {
     if (stopped())
         return;
 
-    // TODO: rewrite the serial blockchain interface to avoid callbacks.
-    // We are using a closure vs. bind to take advantage of move arg syntax.
-    const auto sender = [&router](message&& response)
+    // The response may be produced on any thread, so it is queued for the
+    // worker thread. We are using a closure vs. bind to take advantage of
+    // move arg syntax. A request is answered once, so that it is counted out
+    // once, and a second response is a handler defect that is dropped.
+    const auto responses = responses_;
+    const auto responded = std::make_shared<std::atomic<bool>>(false);
+    const auto sender = [responses, responded](message&& response)
     {
-        const auto ec = response.send(router);
-
-        if (ec && ec != (code)error::service_stopped)
-            log::warning(LOG_SERVER)
-                << "Failed to send query response to "
-                << response.route().display() << " " << ec.message();
+        if (responded->exchange(true))
+        {
+            BITCOIN_ASSERT_MSG(false, "query responded more than once");
+            return;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        unique_lock lock(responses->mutex);
+        responses->responses.push_back(std::move(response));
+        ///////////////////////////////////////////////////////////////////////
     };
 
     message request(secure_);
@@ -139,6 +162,9 @@ void query_worker::query(zmq::socket& router)
     if (ec == (code)error::service_stopped)
         return;
 
+    // Each path below responds once.
+    ++responses_->outstanding;
+
     if (ec)
     {
         log::debug(LOG_SERVER)
@@ -175,6 +201,32 @@ void query_worker::query(zmq::socket& router)
     query_execute(request, sender);
 }
 
+// Send the responses completed since the last call, on the worker thread.
+void query_worker::respond(zmq::socket& router)
+{
+    std::deque<message> responses;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    responses_->mutex.lock();
+    std::swap(responses, responses_->responses);
+    responses_->mutex.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    for (auto& response: responses)
+    {
+        BITCOIN_ASSERT(responses_->outstanding > 0);
+        --responses_->outstanding;
+
+        const auto ec = response.send(router);
+
+        if (ec && ec != (code)error::service_stopped)
+            log::warning(LOG_SERVER)
+                << "Failed to send query response to "
+                << response.route().display() << " " << ec.message();
+    }
+}
+
 // Query Interface.
 // ----------------------------------------------------------------------------
 
@@ -206,6 +258,9 @@ void query_worker::attach(const std::string& command,
 ///protocol.fetch_stealth is deprecated in v3.
 // protocol.fetch_stealth2 is new in v3.
 //-----------------------------------------------------------------------------
+// blockchain.fetch_histories and blockchain.fetch_transactions are batched
+// forms of fetch_history and fetch_transaction (uchain extension).
+//-----------------------------------------------------------------------------
 // blockchain.broadcast_transaction is deprecated in v3 (deferred).
 // transaction_pool.broadcast (with radar) is new in v3 (deferred).
 //=============================================================================
@@ -218,11 +273,13 @@ void query_worker::attach_interface()
     ATTACH(address, unsubscribe2, node_);
     ATTACH(address, fetch_history2, node_);
     ATTACH(blockchain, fetch_history, node_);
+    ATTACH(blockchain, fetch_histories, node_);
     ATTACH(blockchain, fetch_block_header, node_);
     ATTACH(blockchain, fetch_block_height, node_);
     ATTACH(blockchain, fetch_block_transaction_hashes, node_);
     ATTACH(blockchain, fetch_last_height, node_);
     ATTACH(blockchain, fetch_transaction, node_);
+    ATTACH(blockchain, fetch_transactions, node_);
     ATTACH(blockchain, fetch_transaction_index, node_);
     ATTACH(blockchain, fetch_spend, node_);
     ATTACH(blockchain, fetch_stealth, node_);
@@ -208,19 +208,18 @@ void sync_fetch_token_cert_balance(const std::string& address, const string& sym
     std::shared_ptr<token_cert::list> sh_vec,
     token_cert_type cert_type)
 {
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    bool is_coinbase;
 
-    auto&& rows = blockchain.get_address_history(wallet::payment_address(address));
+    const wallet::payment_address payment_address(address);
+    auto&& rows = blockchain.get_address_history(payment_address);
     for (auto& row: rows)
     {
         // spend unconfirmed (or no spend attempted)
         if ((row.spend.hash == null_hash)
-                && blockchain.get_transaction(row.output.hash, tx_temp, tx_height))
+                && blockchain.get_output(row.output, output, is_coinbase))
         {
-            BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-            const auto& output = tx_temp.outputs.at(row.output.index);
-            if (output.get_script_address() != address) {
+            if (!output.is_script_address(payment_address)) {
                 continue;
             }
             if (output.is_token_cert())
@@ -243,10 +242,11 @@ void sync_fetch_token_balance(const std::string& address, bool sum_all,
     bc::blockchain::block_chain_impl& blockchain,
     std::shared_ptr<token_balances::list> sh_token_vec)
 {
-    auto&& rows = blockchain.get_address_history(wallet::payment_address(address));
+    const wallet::payment_address payment_address(address);
+    auto&& rows = blockchain.get_address_history(payment_address);
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    bool is_coinbase;
     uint64_t height = 0;
     blockchain.get_last_height(height);
 
@@ -254,11 +254,9 @@ void sync_fetch_token_balance(const std::string& address, bool sum_all,
     {
         // spend unconfirmed (or no spend attempted)
         if ((row.spend.hash == null_hash)
-                && blockchain.get_transaction(row.output.hash, tx_temp, tx_height))
+                && blockchain.get_output(row.output, output, is_coinbase))
         {
-            BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-            const auto& output = tx_temp.outputs.at(row.output.index);
-            if (output.get_script_address() != address) {
+            if (!output.is_script_address(payment_address)) {
                 continue;
             }
             if (output.is_token())
@@ -302,8 +300,8 @@ void sync_fetch_token_deposited_balance(const std::string& address,
 {
     auto&& rows = blockchain.get_address_history(wallet::payment_address(address));
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    bool is_coinbase;
     uint64_t height = 0;
     blockchain.get_last_height(height);
 
@@ -311,10 +309,8 @@ void sync_fetch_token_deposited_balance(const std::string& address,
     {
         // spend unconfirmed (or no spend attempted)
         if ((row.spend.hash == null_hash)
-                && blockchain.get_transaction(row.output.hash, tx_temp, tx_height))
+                && blockchain.get_output(row.output, output, is_coinbase))
         {
-            BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-            const auto& output = tx_temp.outputs.at(row.output.index);
             if (output.is_token())
             {
                 if (!operation::is_pay_key_hash_with_attenuation_model_pattern(output.script.operations)) {
@@ -573,7 +569,7 @@ void sync_fetch_deposited_balance(wallet::payment_address& address,
                 && blockchain.get_transaction(row.output.hash, tx_temp, tx_height)) {
             BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
             auto output = tx_temp.outputs.at(row.output.index);
-            if (output.get_script_address() != address.encoded()) {
+            if (!output.is_script_address(address)) {
                 continue;
             }
 
@@ -627,8 +623,8 @@ void sync_fetchbalance(wallet::payment_address& address,
     uint64_t unspent_balance = 0;
     uint64_t frozen_balance = 0;
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
+    chain::output output;
+    bool is_coinbase;
     uint64_t height = 0;
     blockchain.get_last_height(height);
 
@@ -639,10 +635,8 @@ void sync_fetchbalance(wallet::payment_address& address,
 
         // spend unconfirmed (or no spend attempted)
         if ((row.spend.hash == null_hash)
-                && blockchain.get_transaction(row.output.hash, tx_temp, tx_height)) {
-            BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-            auto output = tx_temp.outputs.at(row.output.index);
-            if (output.get_script_address() != address.encoded()) {
+                && blockchain.get_output(row.output, output, is_coinbase)) {
+            if (!output.is_script_address(address)) {
                 continue;
             }
 
@@ -655,7 +649,7 @@ void sync_fetchbalance(wallet::payment_address& address,
                     frozen_balance += row.value;
                 }
             }
-            else if (tx_temp.is_coinbase()) { // coin base ucn maturity ucn check
+            else if (is_coinbase) { // coin base ucn maturity ucn check
                 // add not coinbase_maturity ucn into frozen
                 if ((row.output_height + coinbase_maturity) > height) {
                     frozen_balance += row.value;
@@ -685,15 +679,11 @@ bool base_transfer_common::get_spendable_output(
         return false;
     }
 
-    chain::transaction tx_temp;
-    uint64_t tx_height;
-    if (!blockchain_.get_transaction(row.output.hash, tx_temp, tx_height)) {
+    bool is_coinbase;
+    if (!blockchain_.get_output(row.output, output, is_coinbase)) {
         return false;
     }
 
-    BITCOIN_ASSERT(row.output.index < tx_temp.outputs.size());
-    output = tx_temp.outputs.at(row.output.index);
-
     if (chain::operation::is_pay_key_hash_with_lock_height_pattern(output.script.operations)) {
         if (row.output_height == 0) {
             // deposit utxo in transaction pool
@@ -707,7 +697,7 @@ bool base_transfer_common::get_spendable_output(
                 return false;
             }
         }
-    } else if (tx_temp.is_coinbase()) { // incase readd deposit
+    } else if (is_coinbase) { // incase readd deposit
         // coin base ucn maturity ucn check
         // coinbase_maturity ucn check
         if (/*(row.output_height == 0) ||*/ ((row.output_height + coinbase_maturity) > height)) {
@@ -741,7 +731,7 @@ void base_transfer_common::sync_fetchutxo(
             continue;
         }
 
-        if (output.get_script_address() != addr) {
+        if (!output.is_script_address(waddr)) {
             continue;
         }
 
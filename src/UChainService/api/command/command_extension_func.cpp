@@ -23,6 +23,7 @@
 #include <memory>
 #include <string>
 #include <array>
+#include <unordered_map>
 
 #include <UChain/explorer/command.hpp>
 #include <UChain/explorer/dispatch.hpp>
@@ -205,176 +206,168 @@ void broadcast_extension(const function<void(shared_ptr<command>)> func, std::os
     func(make_shared<showuid>());*/
 }
 
-shared_ptr<command> find_extension(const string& symbol)
-{
-    using namespace std;
-    using namespace commands;
-
-    // account
-    if (symbol == createaccount::symbol())
-        return make_shared<createaccount>();
-    if (symbol == checkaccountinfo::symbol())
-        return make_shared<checkaccountinfo>();
-    if (symbol == deleteaccount::symbol())
-        return make_shared<deleteaccount>();
-    if (symbol == changepass::symbol())
-        return make_shared<changepass>();
-    if (symbol == validateaddress::symbol())
-        return make_shared<validateaddress>();
-    if (symbol == addaddress::symbol())
-        return make_shared<addaddress>();
-    if (symbol == showaddresses::symbol())
-        return make_shared<showaddresses>();
-    if (symbol == importaccount::symbol())
-        return make_shared<importaccount>();
-    if (symbol == exportkeyfile::symbol() || symbol == "exportaccountasfile")
-        return make_shared<exportkeyfile>();
-    if (symbol == importkeyfile::symbol() || symbol == "importaccountfromfile")
-        return make_shared<importkeyfile>();
-
-    // system
-    if (symbol == shutdown::symbol())
-        return make_shared<shutdown>();
-    if (symbol == showinfo::symbol())
-        return make_shared<showinfo>();
-    if (symbol == addnode::symbol())
-        return make_shared<addnode>();
-    if (symbol == showpeerinfo::symbol())
-        return make_shared<showpeerinfo>();
-
-    // mining
-    if (symbol == stopmining::symbol() || symbol == "stop")
-        return make_shared<stopmining>();
-    if (symbol == startmining::symbol() || symbol == "start")
-        return make_shared<startmining>();
-    if (symbol == setminingaccount::symbol())
-        return make_shared<setminingaccount>();
-    if (symbol == showmininginfo::symbol())
-        return make_shared<showmininginfo>();
-    if ((symbol == showwork::symbol()) || (symbol == "eth_showwork"))
-        return make_shared<showwork>();
-    if ((symbol == submitwork::symbol()) || ( symbol == "eth_submitWork"))
-        return make_shared<submitwork>();
-    if (symbol == showmemorypool::symbol())
-        return make_shared<showmemorypool>();
-
-    // block & tx
-    if (symbol == showblockheight::symbol())
-        return make_shared<showblockheight>();
-    if (symbol == "fetch-height")
-        return make_shared<showblockheight>(symbol);
-    if (symbol == showblock::symbol())
-        return make_shared<showblock>();
-    if (symbol == "getbestblockhash")
-        return make_shared<showblockheader>(symbol);
-    if (symbol == showblockheader::symbol() || symbol == "fetch-header" || symbol == "getbestblockheader")
-        return make_shared<showblockheader>();
-    if (symbol == showheaderext::symbol())
-        return make_shared<showheaderext>();
-    if (symbol == showtx::symbol() || symbol == "gettransaction")
-        return make_shared<showtx>();
-    if (symbol == "fetch-tx")
-        return make_shared<showtx>(symbol);
-    if (symbol == showtxs::symbol())
-        return make_shared<showtxs>();
-
-    // raw tx
-    if (symbol == createrawtx::symbol())
-        return make_shared<createrawtx>();
-    if (symbol == decoderawtx::symbol())
-        return make_shared<decoderawtx>();
-    if (symbol == signrawtx::symbol())
-        return make_shared<signrawtx>();
-    if (symbol == sendrawtx::symbol())
-        return make_shared<sendrawtx>();
-
-    // multi-sig
-    if (symbol == checkpublickey::symbol())
-        return make_shared<checkpublickey>();
-    if (symbol == createmultisigaddress::symbol())
-        return make_shared<createmultisigaddress>();
-    if (symbol == showmultisigaddress::symbol())
-        return make_shared<showmultisigaddress>();
-    if (symbol == deletemultisigaddress::symbol())
-        return make_shared<deletemultisigaddress>();
-    if (symbol == createmultisigtx::symbol())
-        return make_shared<createmultisigtx>();
-    if (symbol == signmultisigtx::symbol())
-        return make_shared<signmultisigtx>();
+namespace {
 
-    // ucn
-    if (symbol == showbalances::symbol())
-        return make_shared<showbalances>();
-    if (symbol == showbalance::symbol())
-        return make_shared<showbalance>();
-    if (symbol == showaddressucn::symbol() || symbol == "fetch-balance")
-        return make_shared<showaddressucn>();
-    if (symbol == deposit::symbol())
-        return make_shared<deposit>();
-    if (symbol == sendto::symbol() || symbol == "uidsendto")
-        return make_shared<sendto>();
-    if (symbol == sendtomulti::symbol() || symbol == "uidsendtomulti")
-        return make_shared<sendtomulti>();
-    if (symbol == sendfrom::symbol() || symbol == "uidsendfrom")
-        return make_shared<sendfrom>();
-
-    // token
-    if (symbol == createtoken::symbol())
-        return make_shared<createtoken>();
-    if (symbol == deletetoken::symbol() || symbol == "deletetoken" )
-        return make_shared<deletetoken>();
-    if (symbol == showtokens::symbol())
-        return make_shared<showtokens>();
-    if (symbol == showtoken::symbol())
-        return make_shared<showtoken>();
-    if (symbol == showaccounttoken::symbol())
-        return make_shared<showaccounttoken>();
-    // if (symbol == showtokenview::symbol())
-    //     return make_shared<showtokenview>();
-    if (symbol == showaddresstoken::symbol())
-        return make_shared<showaddresstoken>();
-    if (symbol == registertoken::symbol())
-        return make_shared<registertoken>();
-    /*if (symbol == registersecondarytoken::symbol() || (symbol == "additionalissue") )
-        return make_shared<registersecondarytoken>();*/
-    if (symbol == sendtokento::symbol() || symbol == "uidsendtokento")
-        return make_shared<sendtokento>();
-    if (symbol == sendtokenfrom::symbol() || symbol == "uidsendtokenfrom")
-        return make_shared<sendtokenfrom>();
-    if (symbol == destroy::symbol())
-        return make_shared<destroy>();
-    if (symbol == swaptoken::symbol())
-        return make_shared<swaptoken>();
-    if (symbol == vote::symbol())
-        return make_shared<vote>();
-
-    // cert
-    /*if (symbol == transfercert::symbol())
-        return make_shared<transfercert>();
-    if (symbol == registercert::symbol())
-        return make_shared<registercert>();*/
+/// Maps every extension symbol and alias onto its command factory.
+/// Built once, so a lookup is a single hash probe rather than a chain of
+/// string comparisons on every request.
+class extension_registry
+{
+public:
+    extension_registry()
+    {
+        using namespace commands;
+
+
+        // account
+        add<createaccount>(createaccount::symbol());
+        add<checkaccountinfo>(checkaccountinfo::symbol());
+        add<deleteaccount>(deleteaccount::symbol());
+        add<changepass>(changepass::symbol());
+        add<validateaddress>(validateaddress::symbol());
+        add<addaddress>(addaddress::symbol());
+        add<showaddresses>(showaddresses::symbol());
+        add<importaccount>(importaccount::symbol());
+        add<exportkeyfile>(exportkeyfile::symbol());
+        add<exportkeyfile>("exportaccountasfile");
+        add<importkeyfile>(importkeyfile::symbol());
+        add<importkeyfile>("importaccountfromfile");
+
+        // system
+        add<shutdown>(shutdown::symbol());
+        add<showinfo>(showinfo::symbol());
+        add<addnode>(addnode::symbol());
+        add<showpeerinfo>(showpeerinfo::symbol());
+
+        // mining
+        add<stopmining>(stopmining::symbol());
+        add<stopmining>("stop");
+        add<startmining>(startmining::symbol());
+        add<startmining>("start");
+        add<setminingaccount>(setminingaccount::symbol());
+        add<showmininginfo>(showmininginfo::symbol());
+        add<showwork>(showwork::symbol());
+        add<showwork>("eth_showwork");
+        add<submitwork>(submitwork::symbol());
+        add<submitwork>("eth_submitWork");
+        add<showmemorypool>(showmemorypool::symbol());
+
+        // block & tx
+        add<showblockheight>(showblockheight::symbol());
+        add_named<showblockheight>("fetch-height");
+        add<showblock>(showblock::symbol());
+        add_named<showblockheader>("getbestblockhash");
+        add<showblockheader>(showblockheader::symbol());
+        add<showblockheader>("fetch-header");
+        add<showblockheader>("getbestblockheader");
+        add<showheaderext>(showheaderext::symbol());
+        add<showtx>(showtx::symbol());
+        add<showtx>("gettransaction");
+        add_named<showtx>("fetch-tx");
+        add<showtxs>(showtxs::symbol());
+
+        // raw tx
+        add<createrawtx>(createrawtx::symbol());
+        add<decoderawtx>(decoderawtx::symbol());
+        add<signrawtx>(signrawtx::symbol());
+        add<sendrawtx>(sendrawtx::symbol());
+
+        // multi-sig
+        add<checkpublickey>(checkpublickey::symbol());
+        add<createmultisigaddress>(createmultisigaddress::symbol());
+        add<showmultisigaddress>(showmultisigaddress::symbol());
+        add<deletemultisigaddress>(deletemultisigaddress::symbol());
+        add<createmultisigtx>(createmultisigtx::symbol());
+        add<signmultisigtx>(signmultisigtx::symbol());
+
+        // ucn
+        add<showbalances>(showbalances::symbol());
+        add<showbalance>(showbalance::symbol());
+        add<showaddressucn>(showaddressucn::symbol());
+        add<showaddressucn>("fetch-balance");
+        add<deposit>(deposit::symbol());
+        add<sendto>(sendto::symbol());
+        add<sendto>("uidsendto");
+        add<sendtomulti>(sendtomulti::symbol());
+        add<sendtomulti>("uidsendtomulti");
+        add<sendfrom>(sendfrom::symbol());
+        add<sendfrom>("uidsendfrom");
+
+        // token
+        add<createtoken>(createtoken::symbol());
+        add<deletetoken>(deletetoken::symbol());
+        add<showtokens>(showtokens::symbol());
+        add<showtoken>(showtoken::symbol());
+        add<showaccounttoken>(showaccounttoken::symbol());
+        // add<showtokenview>(showtokenview::symbol());
+        add<showaddresstoken>(showaddresstoken::symbol());
+        add<registertoken>(registertoken::symbol());
+        /*add<registersecondarytoken>(registersecondarytoken::symbol());
+        add<registersecondarytoken>("additionalissue");*/
+        add<sendtokento>(sendtokento::symbol());
+        add<sendtokento>("uidsendtokento");
+        add<sendtokenfrom>(sendtokenfrom::symbol());
+        add<sendtokenfrom>("uidsendtokenfrom");
+        add<destroy>(destroy::symbol());
+        add<swaptoken>(swaptoken::symbol());
+        add<vote>(vote::symbol());
+
+        // cert
+        /*add<transfercert>(transfercert::symbol());
+        add<registercert>(registercert::symbol());*/
+
+        // mit
+        /*add<registercard>(registercard::symbol());
+        add<transfercard>(transfercard::symbol());
+        add<showcards>(showcards::symbol());
+        add<showcard>(showcard::symbol());*/
+
+        // uid
+        /*add<registeruid>(registeruid::symbol());
+        add<transferuid>(transferuid::symbol());
+        add<showuids>(showuids::symbol());
+        add<showuid>(showuid::symbol());*/
+
+
+
+    }
+
+    std::shared_ptr<command> find(const std::string& symbol) const
+    {
+        const auto it = factories_.find(symbol);
+        return it == factories_.end() ? nullptr : it->second();
+    }
+
+private:
+    typedef std::function<std::shared_ptr<command>()> factory;
+
+    // The first registration of a symbol wins.
+    template <typename Command>
+    void add(const std::string& symbol)
+    {
+        factories_.emplace(symbol, []() {
+            return std::make_shared<Command>();
+        });
+    }
+
+    // The command is constructed with the alias it was invoked as.
+    template <typename Command>
+    void add_named(const std::string& symbol)
+    {
+        factories_.emplace(symbol, [symbol]() {
+            return std::make_shared<Command>(symbol);
+        });
+    }
+
+    std::unordered_map<std::string, factory> factories_;
+};
+
+} // namespace
 
-    // mit
-    /*if (symbol == registercard::symbol())
-        return make_shared<registercard>();
-    if (symbol == transfercard::symbol())
-        return make_shared<transfercard>();
-    if (symbol == showcards::symbol())
-        return make_shared<showcards>();
-    if (symbol == showcard::symbol())
-        return make_shared<showcard>();*/
-
-    // uid
-    /*if (symbol == registeruid::symbol())
-        return make_shared<registeruid>();
-    if (symbol == transferuid::symbol())
-        return make_shared<transferuid>();
-    if (symbol == showuids::symbol())
-        return make_shared<showuids>();
-    if (symbol == showuid::symbol())
-        return make_shared<showuid>();*/
-
-    return nullptr;
+shared_ptr<command> find_extension(const string& symbol)
+{
+    static const extension_registry registry;
+    return registry.find(symbol);
 }
 
 std::string formerly_extension(const string& former)
@@ -70,27 +70,24 @@ console_result addaddress::invoke(Json::Value& jv_output,
         payment_version = 127 ;
     }
 
-    for (uint32_t idx = 0; idx < option_.count; idx++ ) {
+    // derive the whole batch from the in-memory root key, each child
+    // already carries its compressed public point.
+    const auto children = private_key.derive_private(acc->get_hd_index(),
+        option_.count);
+    if (children.size() != option_.count) {
+        throw address_generate_exception("derive hd private key failed");
+    }
+
+    for (const auto& child : children) {
 
         auto addr = std::make_shared<bc::chain::account_address>();
         addr->set_name(auth_.name);
 
-        const auto child_private_key = private_key.derive_private(acc->get_hd_index());
-        auto hk = child_private_key.encoded();
-
-        // Create the private key from hd_key and the public version.
-        const auto derive_private_key = bc::wallet::hd_private(hk, prefixes);
-        auto pk = encode_base16(derive_private_key.secret());
-
+        auto pk = encode_base16(child.secret());
         addr->set_prv_key(pk.c_str(), auth_.auth);
-        // not store public key now
-        ec_compressed point;
-        libbitcoin::secret_to_public(point, derive_private_key.secret());
-
-        // Serialize to the original compression state.
-        auto ep =  ec_public(point, true);
 
-        payment_address pa(ep, payment_version);
+        // not store public key now
+        payment_address pa(ec_public(child.point(), true), payment_version);
 
         addr->set_address(pa.encoded());
         addr->set_status(1); // 1 -- enable address
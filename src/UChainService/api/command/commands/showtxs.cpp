@@ -18,6 +18,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <unordered_map>
+#include <unordered_set>
 #include <UChain/explorer/json_helper.hpp>
 #include <UChain/explorer/dispatch.hpp>
 #include <UChainService/api/command/commands/showtxs.hpp>
@@ -95,12 +97,24 @@ console_result showtxs::invoke(Json::Value& jv_output,
     auto sh_txs = std::make_shared<std::vector<tx_block_info>>();
     auto sh_addr_vec = std::make_shared<std::vector<std::string>>();
 
+    // load account addresses once, ownership of every input and output
+    // below is then a set lookup instead of an account database scan.
+    auto pvaddr = blockchain.get_account_addresses(auth_.name);
+    if (!pvaddr)
+        throw address_invalid_exception{"nullptr for address list"};
+
+    std::unordered_set<std::string> account_addrs;
+    account_addrs.reserve(pvaddr->size());
+    for (auto& elem : *pvaddr) {
+        account_addrs.insert(elem.get_address());
+    }
+
+    auto is_own_address = [&account_addrs](const std::string & address) {
+        return account_addrs.find(address) != account_addrs.end();
+    };
+
     // collect address
     if (argument_.address.empty()) {
-        auto pvaddr = blockchain.get_account_addresses(auth_.name);
-        if (!pvaddr)
-            throw address_invalid_exception{"nullptr for address list"};
-
         for (auto& elem : *pvaddr) {
             sh_addr_vec->push_back(elem.get_address());
         }
@@ -151,6 +165,9 @@ console_result showtxs::invoke(Json::Value& jv_output,
     // sort by height
     std::vector<tx_block_info> result(sh_txs->begin() + start, sh_txs->begin() + start + tx_count);
 
+    // decimal number of transferred tokens, by symbol.
+    std::unordered_map<std::string, std::shared_ptr<token_detail>> issued_tokens;
+
     // fetch tx according its hash
     std::vector<std::string> vec_ip_addr; // input addr
     chain::transaction tx;
@@ -213,7 +230,7 @@ console_result showtxs::invoke(Json::Value& jv_output,
             if (address) {
                 auto&& temp_addr = address.encoded();
                 pt_output["address"] = temp_addr;
-                auto ret = blockchain.get_account_address(auth_.name, temp_addr);
+                auto ret = is_own_address(temp_addr);
                 if (get_api_version() == 1)
                     pt_output["own"] = ret ? "true" : "false";
                 else
@@ -259,7 +276,13 @@ console_result showtxs::invoke(Json::Value& jv_output,
                     // token_transfer dose not contain decimal_number message,
                     // so we get decimal_number from the issued token with the same symbol.
                     auto symbol = tree["symbol"].asString();
-                    auto issued_token = blockchain.get_issued_token(symbol);
+                    auto token_it = issued_tokens.find(symbol);
+                    if (token_it == issued_tokens.end()) {
+                        token_it = issued_tokens.emplace(symbol,
+                            blockchain.get_issued_token(symbol)).first;
+                    }
+
+                    const auto& issued_token = token_it->second;
 
                     if (issued_token) {
                         if (get_api_version() == 1) {
@@ -286,9 +309,7 @@ console_result showtxs::invoke(Json::Value& jv_output,
 
         // set tx direction
         // 1. receive check
-        auto pos = std::find_if(vec_ip_addr.begin(), vec_ip_addr.end(), [&](const std::string & i) {
-            return blockchain.get_account_address(auth_.name, i) != nullptr;
-        });
+        auto pos = std::find_if(vec_ip_addr.begin(), vec_ip_addr.end(), is_own_address);
 
         if (pos == vec_ip_addr.end()) {
             tx_item["direction"] = "receive";
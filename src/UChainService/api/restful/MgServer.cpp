@@ -103,6 +103,15 @@ bool MgServer::send_frame(struct mg_connection& nc, const char* msg, size_t len,
     return true;
 }
 
+bool MgServer::send_frame(struct mg_connection& nc, const std::vector<mg_str>& parts, bool binary)
+{
+    if (!nc_ || !running_)
+        return false;
+
+    mg_send_websocket_framev(&nc, (binary ? WEBSOCKET_OP_BINARY : WEBSOCKET_OP_TEXT), parts.data(), static_cast<int>(parts.size()));
+    return true;
+}
+
 void MgServer::run() {
     while (running_)
     {
@@ -22,6 +22,39 @@
 
 namespace mgbubble {
 
+const Json::Value& HttpMessage::data_to_json(uint8_t rpc_version) {
+
+    Json::Reader reader;
+    const char* begin = body().data();
+    const char* end = body().data() + body().size();
+    if (!reader.parse(begin, end, root_) || !root_.isObject()) {
+        throw libbitcoin::explorer::jsonrpc_parse_error();
+    }
+
+    if (root_.isMember("params") && !root_["params"].isArray()) {
+        throw libbitcoin::explorer::jsonrpc_invalid_params();
+    }
+
+    if (rpc_version != 1) {
+        const vector<std::string> api20_ver_list = {"2.0", "3.0"};
+        auto checkAPIVer = [](const vector<std::string> &api_ver_list, const std::string &rpc_version){
+            return find(api_ver_list.begin(), api_ver_list.end(), rpc_version) != api_ver_list.end();
+        };
+
+        if (!checkAPIVer(api20_ver_list, root_["jsonrpc"].asString())) {
+            throw libbitcoin::explorer::jsonrpc_invalid_request();
+        }
+
+        if (root_["id"].isString()) {
+            jsonrpc_id_ = std::stol(root_["id"].asString());
+        } else {
+            jsonrpc_id_ = root_["id"].asInt64();
+        }
+    }
+
+    return root_;
+}
+
 void HttpMessage::data_to_arg(uint8_t rpc_version) {
 
     auto vargv_to_argv = [this]() {
@@ -36,22 +69,12 @@ void HttpMessage::data_to_arg(uint8_t rpc_version) {
         argc_ = i;
     };
 
-    Json::Reader reader;
-    Json::Value root;
-    const char* begin = body().data();
-    const char* end = body().data() + body().size();
-    if (!reader.parse(begin, end, root) || !root.isObject()) {
-        throw libbitcoin::explorer::jsonrpc_parse_error();
-    }
+    const auto& root = data_to_json(rpc_version);
 
     if (root["method"].isString()) {
         vargv_.emplace_back(root["method"].asString());
     }
 
-    if (root.isMember("params") && !root["params"].isArray()) {
-        throw libbitcoin::explorer::jsonrpc_invalid_params();
-    }
-
     if (rpc_version == 1) {
         /* ***************** /rpc **********************
          * application/json
@@ -77,21 +100,6 @@ void HttpMessage::data_to_arg(uint8_t rpc_version) {
          *  }
          * ******************************************/
 
-        const vector<std::string> api20_ver_list = {"2.0", "3.0"};
-        auto checkAPIVer = [](const vector<std::string> &api_ver_list, const std::string &rpc_version){
-            return find(api_ver_list.begin(), api_ver_list.end(), rpc_version) != api_ver_list.end();
-        };
-
-        if (!checkAPIVer(api20_ver_list, root["jsonrpc"].asString())) {
-            throw libbitcoin::explorer::jsonrpc_invalid_request();
-        }
-
-        if (root["id"].isString()) {
-            jsonrpc_id_ = std::stol(root["id"].asString());
-        } else {
-            jsonrpc_id_ = root["id"].asInt64();
-        }
-
         // push options
         for (auto& param : root["params"]) {
             if (param.isObject()) {
@@ -23,10 +23,13 @@
 
 #include <UChainService/api/command/command_extension_func.hpp>
 #include <UChainService/api/command/exception.hpp>
+#include <UChain/explorer/json_helper.hpp>
 #include <UChain/server/server_node.hpp>
 
 namespace mgbubble {
 
+using json_helper = libbitcoin::explorer::config::json_helper;
+
 thread_local OStream RestServ::out_;
 thread_local Tokeniser<'/'> RestServ::uri_;
 thread_local int RestServ::state_ = 0;
@@ -66,34 +69,43 @@ void RestServ::rpc_request(mg_connection& nc, HttpMessage data, uint8_t rpc_vers
         return find(api_ver_list.begin(), api_ver_list.end(), rpc_version) != api_ver_list.end();
     };
     try {
-        data.data_to_arg(rpc_version);
-
         Json::Value jv_output;
+        console_result retcode;
 
-        auto retcode = explorer::dispatch_command(data.argc(), const_cast<const char**>(data.argv()),
+        if (rpc_version == 1) {
+            data.data_to_arg(rpc_version);
+            retcode = explorer::dispatch_command(data.argc(), const_cast<const char**>(data.argv()),
+                       jv_output, node_, rpc_version);
+        }
+        else {
+            // bind params straight into the command, no argv round trip.
+            data.data_to_json(rpc_version);
+            retcode = explorer::dispatch_command(data.json_method(), data.json_params(),
                        jv_output, node_, rpc_version);
+        }
 
         if (retcode == console_result::failure) { // only orignal command
             if (rpc_version == 1 && !jv_output.isObject() && !jv_output.isArray()) {
                 throw explorer::command_params_exception{ jv_output.asString() };
             }
-            throw explorer::command_params_exception{ jv_output.toStyledString() };
+            std::ostringstream error;
+            json_helper::write(error, jv_output);
+            throw explorer::command_params_exception{ error.str() };
         }
 
         if (retcode == console_result::okay) {
             if (rpc_version == 1) {
                 if (jv_output.isObject() || jv_output.isArray())
-                    out_ << jv_output.toStyledString();
+                    json_helper::write(out_, jv_output);
                 else
                     out_ << jv_output.asString();
             }
             else if (checkAPIVer(api20_ver_list, rpc_version)) {
-                Json::Value jv_root;
-                jv_root["jsonrpc"] = "2.0";
-                jv_root["id"] = data.jsonrpc_id();
-                jv_root["result"] = jv_output;
-
-                out_ << jv_root.toStyledString();
+                // stream the envelope around the result instead of copying
+                // the result into a new tree, members in Json::Value order.
+                out_ << "{\"id\":" << data.jsonrpc_id() << ",\"jsonrpc\":\"2.0\",\"result\":";
+                json_helper::write(out_, jv_output);
+                out_ << "}";
             }
         }
     }
@@ -108,7 +120,7 @@ void RestServ::rpc_request(mg_connection& nc, HttpMessage data, uint8_t rpc_vers
             root["error"]["code"] = (int32_t)e.code();
             root["error"]["message"] = e.what();
 
-            out_ << root.toStyledString();
+            json_helper::write(out_, root);
         }
     }
     catch (const std::exception& e) {
@@ -123,7 +135,7 @@ void RestServ::rpc_request(mg_connection& nc, HttpMessage data, uint8_t rpc_vers
             root["error"]["code"] = 1000;
             root["error"]["message"] = e.what();
 
-            out_ << root.toStyledString();
+            json_helper::write(out_, root);
         }
     }
     out_.setContentLength();
@@ -147,8 +159,11 @@ void RestServ::ws_request(mg_connection& nc, WebsocketMessage ws)
         jv_output["error"]["message"] = e.what();
     }
 
-    if (jv_output.isObject() || jv_output.isArray())
-        send_frame(nc, jv_output.toStyledString());
+    if (jv_output.isObject() || jv_output.isArray()) {
+        std::ostringstream output;
+        json_helper::write(output, jv_output);
+        send_frame(nc, output.str());
+    }
     else
         send_frame(nc, jv_output.asString());
 }
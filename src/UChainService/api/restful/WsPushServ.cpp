@@ -180,14 +180,15 @@ void WsPushServ::notify_block_impl(uint32_t height, const bc::chain::block::ptr
     }
 
     if (notify_block_cons.size() > 0) {
-        Json::Value root;
-        root["event"] = EV_PUBLISH;
-        root["channel"] = CH_BLOCK;
-        root["result"] = get_json_helper().prop_tree(*block, true, true);
+        // stream the block straight into the frame, members in Json::Value order.
+        std::ostringstream output;
+        output << "{\"channel\":\"" << CH_BLOCK << "\",\"event\":\"" << EV_PUBLISH << "\",\"result\":";
+        get_json_helper().write(output, *block, true, true);
+        output << "}";
 
         // log::info(NAME) << " ******** notify_block: height [" << height << "]  ******** ";
 
-        do_notify(notify_block_cons, root);
+        do_notify(notify_block_cons, std::make_shared<const std::string>(output.str()));
     }
 
     if (notify_height_cons.size() > 0) {
@@ -204,11 +205,20 @@ void WsPushServ::notify_block_impl(uint32_t height, const bc::chain::block::ptr
 
 void WsPushServ::do_notify(
     const std::vector<std::weak_ptr<mg_connection>>& notify_cons,
-    Json::Value& root,
+    const Json::Value& root,
     std::shared_ptr<connection_string_map> topic_map)
 {
-    auto orignal_rep = root.toStyledString();
+    std::ostringstream output;
+    get_json_helper().write(output, root);
+    do_notify(notify_cons, std::make_shared<const std::string>(output.str()), topic_map);
+}
 
+void WsPushServ::do_notify(
+    const std::vector<std::weak_ptr<mg_connection>>& notify_cons,
+    std::shared_ptr<const std::string> frame,
+    std::shared_ptr<connection_string_map> topic_map)
+{
+    // the event is serialized once, every subscriber shares these bytes.
     for (auto& con : notify_cons)
     {
         auto shared_con = con.lock();
@@ -216,37 +226,37 @@ void WsPushServ::do_notify(
             continue;
         }
 
-        std::string rep;
+        // "topic" sorts after every other member, so a subscriber specific
+        // topic is spliced in before the closing brace of the shared frame.
+        std::string topic;
         if (topic_map != nullptr) {
             auto iter = topic_map->find(con);
             if (iter != topic_map->end()) {
                 auto& topics = iter->second;
+                Json::Value value;
                 if (topics.end() != std::find(topics.begin(), topics.end(), CH_ALL)) {
-                    root["topic"] = CH_ALL;
+                    value = CH_ALL;
                 }
                 else if (topics.size() == 1) {
-                    root["topic"] = topics[0];
+                    value = topics[0];
                 }
                 else {
-                    Json::Value value;
                     for (auto& topic : topics) {
                         value.append(topic);
                     }
                     if (value.isNull())
                         value.resize(0);
-
-                    root["topic"] = value;
                 }
 
-                rep = root.toStyledString();
+                std::ostringstream output;
+                output << ",\"topic\":";
+                get_json_helper().write(output, value);
+                output << "}";
+                topic = output.str();
             }
         }
 
-        if (rep.empty()) {
-            rep = orignal_rep;
-        }
-
-        spawn_to_mongoose([this, shared_con, rep](uint64_t id) {
+        spawn_to_mongoose([this, shared_con, frame, topic](uint64_t id) {
             size_t active_connections = 0;
             auto* mgr = &this->mg_mgr();
             auto* notify_nc = shared_con.get();
@@ -255,7 +265,14 @@ void WsPushServ::do_notify(
                     continue;
                 ++active_connections;
                 if (notify_nc == nc) {
-                    send_frame(*nc, rep);
+                    if (topic.empty()) {
+                        send_frame(*nc, *frame);
+                    }
+                    else {
+                        send_frame(*nc, std::vector<mg_str>{
+                            { frame->data(), frame->size() - 1 },
+                            { topic.data(), topic.size() } });
+                    }
                 }
             }
 
@@ -266,74 +283,92 @@ void WsPushServ::do_notify(
     }
 }
 
+bc::binary WsPushServ::to_address_key(const payment_address& address)
+{
+    return bc::binary(address_key_bits,
+        build_chunk({ to_array(address.version()), address.hash() }));
+}
+
 void WsPushServ::notify_transaction(uint32_t height, const hash_digest& block_hash, const transaction& tx)
 {
     if (stopped() || tx.outputs.empty()) {
         return;
     }
 
-    connection_string_map subscribers;
     {
         std::lock_guard<std::mutex> guard(subscribers_lock_);
-        if (subscribers_.size() == 0) {
+        if (subscriber_index_.empty()) {
             return;
         }
-
-        for (auto& con : subscribers_) {
-            if (!con.first.expired()) {
-                subscribers.insert(con);
-            }
-        }
-
-        if (subscribers.size() != subscribers_.size()) {
-            subscribers_ = subscribers;
-        }
     }
 
     /* ---------- may has subscribers ---------- */
 
-    string_vector tx_addrs;
-    for (const auto& input : tx.inputs) {
-        const auto address = payment_address::extract(input.script);
-        if (address) {
-            auto addr_hash = address.encoded();
-            if (tx_addrs.end() == std::find(tx_addrs.begin(), tx_addrs.end(), addr_hash)) {
-                tx_addrs.push_back(addr_hash);
-            }
+    std::vector<payment_address> tx_addrs;
+    const auto add_address = [&tx_addrs](const payment_address& address) {
+        if (address && tx_addrs.end() == std::find(tx_addrs.begin(), tx_addrs.end(), address)) {
+            tx_addrs.push_back(address);
         }
+    };
+
+    for (const auto& input : tx.inputs) {
+        add_address(payment_address::extract(input.script));
     }
 
     for (const auto& output : tx.outputs) {
-        const auto address = payment_address::extract(output.script);
-        if (address) {
-            auto addr_hash = address.encoded();
-            if (tx_addrs.end() == std::find(tx_addrs.begin(), tx_addrs.end(), addr_hash)) {
-                tx_addrs.push_back(addr_hash);
-            }
-        }
+        add_address(payment_address::extract(output.script));
     }
 
     std::shared_ptr<connection_string_map> topic_map = std::make_shared<connection_string_map>();
-
     std::vector<std::weak_ptr<mg_connection>> notify_cons;
-    for (auto& sub : subscribers)
+    std::vector<std::weak_ptr<mg_connection>> expired_cons;
+
+    const auto add_topic = [&](const std::weak_ptr<mg_connection>& con, const std::string& topic) {
+        if (con.expired()) {
+            if (expired_cons.end() == std::find_if(expired_cons.begin(), expired_cons.end(),
+                    [&con](const std::weak_ptr<mg_connection>& item) { return !con.owner_before(item) && !item.owner_before(con); })) {
+                expired_cons.push_back(con);
+            }
+            return;
+        }
+
+        auto& topics = (*topic_map)[con];
+        if (topics.empty()) {
+            notify_cons.push_back(con);
+        }
+        topics.push_back(topic);
+    };
+
     {
-        string_vector topics;
-        auto& sub_addrs = sub.second;
-        if (sub_addrs.empty()) {
-            topics.push_back(CH_ALL);
+        std::lock_guard<std::mutex> guard(subscribers_lock_);
+
+        // An empty filter subscribes to all transactions.
+        connection_index::subscribers matches;
+        subscriber_index_.find(bc::binary(), matches);
+        for (const auto& con : matches) {
+            add_topic(con, CH_ALL);
         }
-        else {
-            for (auto& addr_hash : sub_addrs) {
-                if (tx_addrs.end() != std::find(tx_addrs.begin(), tx_addrs.end(), addr_hash)) {
-                    topics.push_back(addr_hash);
+
+        const auto all_subscribers = matches.size();
+        for (const auto& address : tx_addrs) {
+            matches.clear();
+            subscriber_index_.find(to_address_key(address), matches);
+            if (matches.size() == all_subscribers) {
+                continue;
+            }
+
+            const auto encoded = address.encoded();
+            for (const auto& con : matches) {
+                auto it = topic_map->find(con);
+                if (it == topic_map->end() || it->second.front() != CH_ALL) {
+                    add_topic(con, encoded);
                 }
             }
         }
 
-        if (!topics.empty()) {
-            topic_map->insert({sub.first, topics});
-            notify_cons.push_back(sub.first);
+        for (const auto& con : expired_cons) {
+            subscriber_index_.remove(con);
+            subscribers_.erase(con);
         }
     }
 
@@ -362,8 +397,9 @@ void WsPushServ::send_bad_response(struct mg_connection& nc, const char* message
     root["event"]  = EV_MG_ERROR;
     root["result"] = result;
 
-    auto&& tmp = root.toStyledString();
-    send_frame(nc, tmp.c_str(), tmp.size());
+    std::ostringstream output;
+    get_json_helper().write(output, root);
+    send_frame(nc, output.str());
 }
 
 void WsPushServ::send_response(struct mg_connection& nc, const std::string& event, const std::string& channel, Json::Value data)
@@ -378,8 +414,9 @@ void WsPushServ::send_response(struct mg_connection& nc, const std::string& even
         root["result"] = data;
     }
 
-    auto&& tmp = root.toStyledString();
-    send_frame(nc, tmp.c_str(), tmp.size());
+    std::ostringstream output;
+    get_json_helper().write(output, root);
+    send_frame(nc, output.str());
 }
 
 void WsPushServ::refresh_connections()
@@ -410,8 +447,9 @@ void WsPushServ::on_ws_handshake_done_handler(struct mg_connection& nc)
     root["event"] = EV_INFO;
     root["result"] = connections;
 
-    auto&& tmp = root.toStyledString();
-    send_frame(nc, tmp);
+    std::ostringstream output;
+    get_json_helper().write(output, root);
+    send_frame(nc, output.str());
 }
 
 void WsPushServ::on_ws_frame_handler(struct mg_connection& nc, websocket_message& msg)
@@ -507,13 +545,20 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection& nc, websocket_message
 
                     if (addresses.empty()) {
                         sub_list.clear();
+                        subscriber_index_.remove(week_con);
+                        subscriber_index_.add(bc::binary(), week_con);
                         send_response(nc, EV_SUBSCRIBED, channel);
                         return;
                     }
 
+                    if (sub_list.empty()) {
+                        subscriber_index_.remove(week_con);
+                    }
+
                     for (const auto& address : addresses) {
                         if (sub_list.end() == std::find(sub_list.begin(), sub_list.end(), address)) {
                             sub_list.push_back(address);
+                            subscriber_index_.add(to_address_key(payment_address(address)), week_con);
                         }
                     }
 
@@ -524,9 +569,14 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection& nc, websocket_message
                     for (const auto& address : addresses) {
                         if (sub_list.end() == std::find(sub_list.begin(), sub_list.end(), address)) {
                             sub_list.push_back(address);
+                            subscriber_index_.add(to_address_key(payment_address(address)), week_con);
                         }
                     }
 
+                    if (sub_list.empty()) {
+                        subscriber_index_.add(bc::binary(), week_con);
+                    }
+
                     subscribers_.insert({ week_con, sub_list });
                     send_response(nc, EV_SUBSCRIBED, channel);
                 }
@@ -541,6 +591,7 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection& nc, websocket_message
                 std::lock_guard<std::mutex> guard(subscribers_lock_);
                 std::weak_ptr<struct mg_connection> week_con(it->second);
                 subscribers_.erase(week_con);
+                subscriber_index_.remove(week_con);
                 send_response(nc, EV_UNSUBSCRIBED, channel);
             }
             else {
@@ -632,6 +683,14 @@ void WsPushServ::on_close_handler(struct mg_connection& nc)
 {
     if (is_websocket(nc))
     {
+        auto it = map_connections_.find(&nc);
+        if (it != map_connections_.end()) {
+            std::lock_guard<std::mutex> guard(subscribers_lock_);
+            std::weak_ptr<struct mg_connection> week_con(it->second);
+            subscribers_.erase(week_con);
+            subscriber_index_.remove(week_con);
+        }
+
         map_connections_.erase(&nc);
     }
 }
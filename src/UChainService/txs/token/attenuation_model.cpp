@@ -23,6 +23,7 @@
 #include <UChain/blockchain/block_chain_impl.hpp>
 #include <UChain/blockchain/validate_transaction.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 
 namespace libbitcoin {
@@ -96,15 +97,32 @@ namespace {
 
 } // end of anonymous namespace
 
+// The parsed entries of a model param, or of the part of it that follows the
+// mutable PN and LH entries. That part is immutable for the life of a token's
+// attenuation model, so it is compiled once and shared by all of its outputs.
+struct compiled_model
+{
+    bool valid;
+    size_t entries;
+    std::unordered_map<std::string, std::vector<uint64_t>> map;
+
+    // All keys parsed, including those with empty (unset) values.
+    std::unordered_set<std::string> keys;
+
+    // Running totals of UC and UQ, empty if either would overflow.
+    std::vector<uint64_t> cycle_sums;
+    std::vector<uint64_t> quantity_sums;
+};
+
+typedef std::shared_ptr<const compiled_model> compiled_model_ptr;
+
 class attenuation_model::impl
 {
 public:
     impl(const std::string& param, bool is_init)
-        : model_param_(param)
+        : model_param_(param), valid_(false), pn_(0), lh_(0), has_pn_(false), has_lh_(false)
     {
-        if (!parse_param(is_init)) {
-            map_.clear();
-        }
+        valid_ = parse_param(is_init);
     }
 
     const std::string& get_model_param() const {
@@ -156,6 +174,15 @@ public:
         return get_numbers("UQ");
     }
 
+    // Running totals of UC and UQ (index i is the sum of the first i items).
+    const std::vector<uint64_t>& get_cycle_sums() const {
+        return valid_ ? model_->cycle_sums : empty_num_vec;
+    }
+
+    const std::vector<uint64_t>& get_quantity_sums() const {
+        return valid_ ? model_->quantity_sums : empty_num_vec;
+    }
+
     data_chunk get_new_model_param(uint64_t PN, uint64_t LH) const {
         auto iter = find_nth_element(model_param_.begin(), model_param_.end(), 2, ';');
         if (iter == model_param_.end()) {
@@ -167,16 +194,25 @@ public:
     }
 
 private:
+    size_t size() const {
+        return model_->map.size() + (has_pn_ ? 1 : 0) + (has_lh_ ? 1 : 0);
+    }
+
+    bool contains(const std::string& key) const {
+        return (has_pn_ && key == "PN") || (has_lh_ && key == "LH") ||
+            model_->map.find(key) != model_->map.end();
+    }
+
     bool validate_keys(model_type model, const std::vector<std::string>& keys) {
-        if (map_.size() != keys.size()) {
-            log::debug(LOG_HEADER) << "The size of keys " << map_.size()
+        if (size() != keys.size()) {
+            log::debug(LOG_HEADER) << "The size of keys " << size()
                 << " for model type " << std::to_string(to_index(model))
                 << " does not equal " << keys.size();
             return false;
         }
 
         for (size_t i = 0; i < keys.size(); ++i) {
-            if (map_.find(keys[i]) == map_.end()) {
+            if (!contains(keys[i])) {
                 log::debug(LOG_HEADER) << "model type " << std::to_string(to_index(model))
                     << " needs key " << keys[i] << " but missed.";
                 return false;
@@ -200,7 +236,7 @@ private:
         }
     }
 
-    bool parse_uint64(const std::string& param, uint64_t& value)
+    static bool parse_uint64(const std::string& param, uint64_t& value)
     {
         for (auto& i : param){
             if (!std::isalnum(i)) {
@@ -212,38 +248,46 @@ private:
         return true;
     }
 
-    bool parse_param(bool is_init=false) {
-        if (model_param_.empty()) {
-            return true;
-        }
+    // Parse the entries of text into a model, the leading entries of a full
+    // param must be PN and LH, and a full param has at least six entries.
+    static compiled_model_ptr compile(const std::string& text, bool full) {
+        auto model = std::make_shared<compiled_model>();
+        model->valid = false;
+        model->entries = 0;
+
         auto is_illegal_char = [](auto c){ return ! (std::isalnum(c) || (c == ',') || (c == ';') || (c == '=')); };
-        auto iter = std::find_if(model_param_.begin(), model_param_.end(), is_illegal_char);
-        if (iter != model_param_.end()) {
+        auto iter = std::find_if(text.begin(), text.end(), is_illegal_char);
+        if (iter != text.end()) {
             log::debug(LOG_HEADER) << "illegal char found at pos "
-                << std::distance(model_param_.begin(), iter) << " : " << *iter;
-            return false;
+                << std::distance(text.begin(), iter) << " : " << *iter;
+            return model;
         }
 
-        if (model_param_.find(",,") != std::string::npos) {
+        if (text.find(",,") != std::string::npos) {
             log::debug(LOG_HEADER) << "',,' is not allowed.";
-            return false;
+            return model;
         }
 
-        const auto& kv_vec = bc::split(model_param_, ";", true);
-        if (kv_vec.size() < 6) {
-            log::debug(LOG_HEADER) << "model param is " << model_param_
-                << ", the model param should at least contain keys of PN, LH, TYPE, LQ, LP, UN";
-            return false;
-        }
-        if (kv_vec[0].find("PN=") != 0) {
-            log::debug(LOG_HEADER) << "the model param first key must be PN";
-            return false;
-        }
-        if (kv_vec[1].find("LH=") != 0) {
-            log::debug(LOG_HEADER) << "the model param second key must be LH";
-            return false;
+        const auto& kv_vec = bc::split(text, ";", true);
+        model->entries = kv_vec.size();
+
+        if (full) {
+            if (kv_vec.size() < 6) {
+                log::debug(LOG_HEADER) << "model param is " << text
+                    << ", the model param should at least contain keys of PN, LH, TYPE, LQ, LP, UN";
+                return model;
+            }
+            if (kv_vec[0].find("PN=") != 0) {
+                log::debug(LOG_HEADER) << "the model param first key must be PN";
+                return model;
+            }
+            if (kv_vec[1].find("LH=") != 0) {
+                log::debug(LOG_HEADER) << "the model param second key must be LH";
+                return model;
+            }
         }
 
+        auto& map = model->map;
         for (const auto& kv : kv_vec) {
             auto vec = bc::split(kv, "=", true);
             if (vec.size() == 2) {
@@ -251,14 +295,16 @@ private:
                 auto values = vec[1];
                 if (key.empty()) {
                     log::debug(LOG_HEADER) << "key-value format is wrong, key is empty in " << kv;
-                    return false;
+                    return model;
                 }
 
-                if (map_.find(key) != map_.end()) {
+                if (map.find(key) != map.end()) {
                     log::debug(LOG_HEADER) << "key-value format is wrong, duplicate key : " << key;
-                    return false;
+                    return model;
                 }
 
+                model->keys.insert(key);
+
                 if (values.empty()) {
                     continue; // empty value as unset.
                 }
@@ -274,7 +320,7 @@ private:
                             }
                             else {
                                 log::debug(LOG_HEADER) << "value is not a number: " << item;
-                                return false;
+                                return model;
                             }
                         }
                     }
@@ -284,21 +330,168 @@ private:
                         }
                         else {
                             log::debug(LOG_HEADER) << "value is not a number: " << values;
-                            return false;
+                            return model;
                         }
                     }
 
-                    map_[key] = std::move(num_vec);
+                    map[key] = std::move(num_vec);
                 }
                 catch (const std::exception& e) {
                     log::debug(LOG_HEADER) << "exception caught: " << e.what();
-                    return false;
+                    return model;
                 }
             } else {
-                log::debug(LOG_HEADER) << "key-value format is wrong, should be key=value format. " << model_param_;
+                log::debug(LOG_HEADER) << "key-value format is wrong, should be key=value format. " << text;
+                return model;
+            }
+        }
+
+        model->cycle_sums = running_totals(map, "UC");
+        model->quantity_sums = running_totals(map, "UQ");
+        model->valid = true;
+        return model;
+    }
+
+    static std::vector<uint64_t> running_totals(
+        const std::unordered_map<std::string, std::vector<uint64_t>>& map,
+        const std::string& key) {
+        std::vector<uint64_t> sums;
+        auto iter = map.find(key);
+        if (iter == map.end()) {
+            return sums;
+        }
+
+        sums.reserve(iter->second.size() + 1);
+        sums.push_back(0);
+        for (const auto& num : iter->second) {
+            if (num > max_uint64 - sums.back()) {
+                return {};
+            }
+            sums.push_back(sums.back() + num);
+        }
+        return sums;
+    }
+
+    // Compiled models by the text that follows PN and LH, bounded by reset.
+    static compiled_model_ptr cached(const std::string& text) {
+        static const size_t capacity = 4096;
+        static std::unordered_map<std::string, compiled_model_ptr> cache;
+        static shared_mutex mutex;
+
+        {
+            shared_lock lock(mutex);
+            auto iter = cache.find(text);
+            if (iter != cache.end()) {
+                return iter->second;
+            }
+        }
+
+        auto model = compile(text, false);
+
+        unique_lock lock(mutex);
+        if (cache.size() >= capacity) {
+            cache.clear();
+        }
+        cache.emplace(text, model);
+        return model;
+    }
+
+    // Match "PN=<alnum>*;LH=<alnum>*;" followed by an entry, returning the
+    // offset of that entry. Such a param splits into entries exactly as the
+    // PN and LH entries followed by the entries of the remainder.
+    static bool split_mutable(const std::string& param, size_t& out_offset) {
+        auto scan = [&param](size_t offset, const char* key, size_t& out_end) {
+            if (param.compare(offset, 3, key) != 0) {
+                return false;
+            }
+            auto end = param.find(';', offset + 3);
+            if (end == std::string::npos) {
+                return false;
+            }
+            for (auto i = offset + 3; i < end; ++i) {
+                if (!std::isalnum(param[i])) {
+                    return false;
+                }
+            }
+            out_end = end;
+            return true;
+        };
+
+        size_t pn_end, lh_end;
+        if (!scan(0, "PN=", pn_end) || !scan(pn_end + 1, "LH=", lh_end)) {
+            return false;
+        }
+
+        out_offset = lh_end + 1;
+        return out_offset < param.size() && param[out_offset] != ';';
+    }
+
+    // Parse a mutable PN or LH value, an empty value as unset.
+    static bool parse_mutable(const std::string& value, uint64_t& out, bool& out_set) {
+        out_set = false;
+        if (value.empty()) {
+            return true;
+        }
+
+        try {
+            if (!parse_uint64(value, out)) {
+                log::debug(LOG_HEADER) << "value is not a number: " << value;
                 return false;
             }
         }
+        catch (const std::exception& e) {
+            log::debug(LOG_HEADER) << "exception caught: " << e.what();
+            return false;
+        }
+
+        out_set = true;
+        return true;
+    }
+
+    bool parse_param(bool is_init=false) {
+        if (model_param_.empty()) {
+            model_ = std::make_shared<compiled_model>();
+            return true;
+        }
+
+        size_t offset;
+        if (!split_mutable(model_param_, offset)) {
+            model_ = compile(model_param_, true);
+        }
+        else {
+            const auto lh_start = model_param_.find(';') + 1;
+            const auto pn = model_param_.substr(3, lh_start - 4);
+            const auto lh = model_param_.substr(lh_start + 3, offset - lh_start - 4);
+            model_ = cached(model_param_.substr(offset));
+
+            if (!model_->valid) {
+                return false;
+            }
+
+            if (model_->entries + 2 < 6) {
+                log::debug(LOG_HEADER) << "model param is " << model_param_
+                    << ", the model param should at least contain keys of PN, LH, TYPE, LQ, LP, UN";
+                return false;
+            }
+
+            if (!parse_mutable(pn, pn_, has_pn_) || !parse_mutable(lh, lh_, has_lh_)) {
+                return false;
+            }
+
+            // A set PN or LH may not be repeated in the immutable part.
+            const auto& keys = model_->keys;
+            if ((has_pn_ && keys.find("PN") != keys.end()) ||
+                (has_lh_ && keys.find("LH") != keys.end())) {
+                log::debug(LOG_HEADER) << "key-value format is wrong, duplicate key in " << model_param_;
+                return false;
+            }
+        }
+
+        if (!model_->valid) {
+            return false;
+        }
+
+        valid_ = true;
 
         // check keys after map is constructed
         if (!check_keys(is_init)) {
@@ -311,8 +504,17 @@ private:
     template<typename T = uint64_t>
     T getnumber(const std::string& key) const {
         BITCOIN_ASSERT(!attenuation_model::is_multi_value_key(key));
-        auto iter = map_.find(key);
-        if (iter == map_.end()) {
+        if (!valid_) {
+            return 0;
+        }
+        if (has_pn_ && key == "PN") {
+            return pn_;
+        }
+        if (has_lh_ && key == "LH") {
+            return lh_;
+        }
+        auto iter = model_->map.find(key);
+        if (iter == model_->map.end()) {
             return 0;
         }
         return iter->second[0];
@@ -320,8 +522,11 @@ private:
 
     const std::vector<uint64_t>& get_numbers(const std::string& key) const {
         BITCOIN_ASSERT(attenuation_model::is_multi_value_key(key));
-        auto iter = map_.find(key);
-        if (iter == map_.end()) {
+        if (!valid_) {
+            return empty_num_vec;
+        }
+        auto iter = model_->map.find(key);
+        if (iter == model_->map.end()) {
             return empty_num_vec;
         }
         return iter->second;
@@ -341,7 +546,12 @@ private:
     std::string model_param_;
 
     // auxilary data
-    std::unordered_map<std::string, std::vector<uint64_t>> map_;
+    compiled_model_ptr model_;
+    bool valid_;
+    uint64_t pn_;
+    uint64_t lh_;
+    bool has_pn_;
+    bool has_lh_;
     static const std::vector<uint64_t> empty_num_vec;
 };
 
@@ -1047,9 +1257,15 @@ uint64_t attenuation_model::get_diff_height(const data_chunk& prev_param, const
 
     else if (model == model_type::custom || model == model_type::fixed_inflation) {
         const auto& UCs = parser.get_unlock_cycles();
+        const auto& sums = parser.pimpl->get_cycle_sums();
         auto diff_height = LH;
-        for (auto i = PN + 1; i <= PN2; ++i) {
-            diff_height += UCs[i];
+        if (PN2 < UCs.size() && PN2 + 1 < sums.size()) {
+            diff_height += sums[PN2 + 1] - sums[PN + 1];
+        }
+        else {
+            for (auto i = PN + 1; i <= PN2; ++i) {
+                diff_height += UCs[i];
+            }
         }
         diff_height -= LH2;
         return diff_height;
@@ -1126,10 +1342,28 @@ uint64_t attenuation_model::get_available_token_amount(
         available += UQs[PN];
         diff_height -= LH;
         ++PN;
-        while ((PN < UN) && (diff_height >= UCs[PN])) {
-            available += UQs[PN];
-            diff_height -= UCs[PN];
-            ++PN;
+
+        // Find the last elapsed cycle by running totals, O(log cycles).
+        const auto& cycle_sums = parser.pimpl->get_cycle_sums();
+        const auto& quantity_sums = parser.pimpl->get_quantity_sums();
+        if (PN <= UN && UN < cycle_sums.size() && UN < quantity_sums.size()) {
+            const auto base = cycle_sums[PN];
+            const auto limit = (diff_height > max_uint64 - base) ?
+                max_uint64 : base + diff_height;
+            const auto first = cycle_sums.begin() + PN;
+            const auto last = cycle_sums.begin() + UN + 1;
+            const auto end = static_cast<uint64_t>(
+                std::upper_bound(first, last, limit) - cycle_sums.begin() - 1);
+            available += quantity_sums[end] - quantity_sums[PN];
+            diff_height -= cycle_sums[end] - base;
+            PN = end;
+        }
+        else {
+            while ((PN < UN) && (diff_height >= UCs[PN])) {
+                available += UQs[PN];
+                diff_height -= UCs[PN];
+                ++PN;
+            }
         }
         if (PN == UN) { // include the last unlock cycle, release all
             return token_amount;